@@ -541,7 +541,7 @@ bool CExchangeContext::SendCheck(bool &data_processed)
    if(m_buffer_send_tmp.Len()>0)
      {
       //--- if data are already sent, set flag of data processing
-      if(res=m_socket->ClientSend(m_buffer_send_tmp.Buffer(),m_buffer_send_tmp.Len()))
+      if(res=m_socket->ClientSend(m_buffer_send_tmp))
         {
          //--- set flag
          data_processed=true;
@@ -624,7 +624,7 @@ uint32_t CExchangeContext::SendSizeGet(void)
 //--- lock outbound packets buffer
    m_buffer_send_sync.Lock();
 //--- get size of send packets buffer
-   uint32_t len=m_buffer_send.Len();
+   uint32_t len=uint32_t(m_buffer_send.Len());
 //--- unlock outbound packets buffer
    m_buffer_send_sync.Unlock();
 //--- return result
@@ -52,8 +52,8 @@ private:
    wchar_t           m_address[MAX_PATH];
    uint32_t          m_port;
    //--- buffers of packets for sending
-   CMTMemPack        m_buffer_send;
-   CMTMemPack        m_buffer_send_tmp;
+   CMTMemPackChunked m_buffer_send;
+   CMTMemPackChunked m_buffer_send_tmp;
    //--- synchronizer of access to packets for sending
    CMTSync           m_buffer_send_sync;
    //--- buffer of receipt packets
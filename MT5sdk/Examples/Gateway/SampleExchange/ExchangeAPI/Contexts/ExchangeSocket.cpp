@@ -123,6 +123,66 @@ bool CExchangeSocket::ClientSend(const char *buf,const uint32_t buf_size)
    return(true);
   }
 //+------------------------------------------------------------------+
+//| Send chunked data by scatter-gather writes                       |
+//+------------------------------------------------------------------+
+bool CExchangeSocket::ClientSend(const CMTMemPackChunked &pack)
+  {
+   WSAOVERLAPPED    send_overlapped;
+   WSABUF           send_buffers[SEND_SEGMENTS_MAX];
+   MTMemPackSegment segments[SEND_SEGMENTS_MAX];
+   DWORD            bytes,send_len;
+   uint32_t         count,first=0;
+//--- check
+   if(pack.Len()==0 || m_socket_client==INVALID_SOCKET)
+      return(false);
+//--- create socket event, if not already
+   if(m_socket_client_event==WSA_INVALID_EVENT)
+     {
+      //--- create
+      if((m_socket_client_event=WSACreateEvent())==WSA_INVALID_EVENT)
+        {
+         //--- remember error description
+         ErrorSet(WSAGetLastError());
+         return(false);
+        }
+     }
+//--- send chunks without copying them to contiguous buffer
+   while((count=pack.Segments(segments,SEND_SEGMENTS_MAX,first))>0)
+     {
+      send_len=0;
+      for(uint32_t i=0; i<count; i++)
+        {
+         send_buffers[i].buf=(char*)segments[i].buf;
+         send_buffers[i].len=segments[i].len;
+         send_len+=segments[i].len;
+        }
+      first+=count;
+      //--- send and check that everything has been send
+      bytes=0;
+      ZeroMemory(&send_overlapped,sizeof(send_overlapped));
+      send_overlapped.hEvent=m_socket_client_event;
+      if(WSASend(m_socket_client,send_buffers,count,&bytes,0,&send_overlapped,NULL)==0 && bytes==send_len)
+         continue;
+      //--- analyze error code
+      DWORD error_code=WSAGetLastError();
+      if(error_code!=WSA_IO_PENDING)
+        {
+         ErrorSet(error_code);
+         ClientClose();
+         return(false);
+        }
+      //--- wait for the end of data sending
+      if(WSAWaitForMultipleEvents(1,&send_overlapped.hEvent,TRUE,m_socket_client_timeout,FALSE)==WSA_WAIT_TIMEOUT)
+        {
+         ErrorSet(WSAGetLastError());
+         ClientClose();
+         return(false);
+        }
+     }
+//--- successful, waited until the end of input/output
+   return(true);
+  }
+//+------------------------------------------------------------------+
 //| Set error description                                            |
 //+------------------------------------------------------------------+
 void CExchangeSocket::ErrorSet(DWORD error_code)
@@ -13,7 +13,8 @@ private:
    //--- constants
    enum EnConstantsSocket
      {
-      DEFAULT_SOCKET_TIMEOUT=10000           // socket default timeout (msec)
+      DEFAULT_SOCKET_TIMEOUT=10000,          // socket default timeout (msec)
+      SEND_SEGMENTS_MAX     =64              // maximum segments per send call
      };
 
    //--- description of socket error, if it will occur
@@ -36,6 +37,7 @@ public:
    //--- read/write socket data
    bool              ClientRead(char *buf,const uint32_t buf_max,uint32_t &buf_readed);
    bool              ClientSend(const char *buf,const uint32_t buf_size);
+   bool              ClientSend(const CMTMemPackChunked &pack);
    //--- set error description
    void              ErrorSet(DWORD error_code);
    //--- set error description
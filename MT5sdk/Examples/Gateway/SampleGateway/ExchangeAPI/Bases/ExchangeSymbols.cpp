@@ -10,7 +10,7 @@
 //| Constructor                                                      |
 //+------------------------------------------------------------------+
 CExchangeSymbols::CExchangeSymbols(CGateway *gateway)
-   : m_gateway(*gateway)
+   : m_gateway(*gateway),m_sync(L"ExchangeSymbols")
   {
   }
 //+------------------------------------------------------------------+
@@ -25,28 +25,34 @@ CExchangeSymbols::~CExchangeSymbols(void)
 bool CExchangeSymbols::OnSymbolAdd(const ExchangeSymbol &exchange_symbol)
   {
    bool res=false;
+//--- intern symbol name
+   uint32_t id=CMTStrIntern::Global().Intern(exchange_symbol.symbol);
+   if(id==CMTStrIntern::INVALID_ID)
+      return(false);
 //--- lock
-   m_sync.Lock();
+   m_sync.LockWrite();
 //--- find symbol in base
-   for(uint32_t i=0;i<m_symbols.Total();i++)
+   int32_t pos=SymbolPosition(exchange_symbol.symbol);
+   if(pos>=0)
      {
-      //--- compare symbol names
-      if(CMTStr::Compare(m_symbols[i].symbol,exchange_symbol.symbol)==0)
-        {
-         //--- symbol found, update it's parameters
-         m_symbols[i]=exchange_symbol;
-         res=true;
-         break;
-        }
+      //--- symbol found, update it's parameters
+      m_symbols[pos]=exchange_symbol;
+      res=true;
      }
-//--- symbol is not found, add new one
+//--- symbol is not found, add new one and index it
    if(!res)
-      res=m_symbols.Add(&exchange_symbol);
-//--- notify gateway of added/updated symbol
+     {
+      uint32_t index_pos=m_symbols.Total()+1,zero=0;
+      //--- index is indexed by ID, fill the gap for names of other bases
+      for(res=true; res && m_symbols_index.Total()<=id;)
+         res=m_symbols_index.Add(&zero);
+      res=res && m_symbols.Add(&exchange_symbol) && m_symbols_index.Update(id,&index_pos);
+     }
+//--- unlock
+   m_sync.UnlockWrite();
+//--- notify gateway of added/updated symbol outside of the lock, it is not recursive
    if(res)
       m_gateway.OnExchangeSymbolAdd(exchange_symbol);
-//--- unlock
-   m_sync.Unlock();
 //--- return result
    return(res);
   }
@@ -150,19 +156,16 @@ bool CExchangeSymbols::SymbolGet(LPCWSTR symbol_name,ExchangeSymbol &symbol)
   {
    bool res=false;
 //--- lock
-   m_sync.Lock();
-   for(uint32_t i=0;i<m_symbols.Total();i++)
+   m_sync.LockRead();
+//--- search
+   int32_t pos=SymbolPosition(symbol_name);
+   if(pos>=0)
      {
-      //--- compare symbol names
-      if(CMTStr::Compare(m_symbols[i].symbol,symbol_name)==0)
-        {
-         res=true;
-         SymbolCopy(m_symbols[i],symbol);
-         break;
-        }
+      res=true;
+      SymbolCopy(m_symbols[pos],symbol);
      }
 //--- unlock
-   m_sync.Unlock();
+   m_sync.UnlockRead();
 //--- return result
    return(res);
   }
@@ -171,25 +174,28 @@ bool CExchangeSymbols::SymbolGet(LPCWSTR symbol_name,ExchangeSymbol &symbol)
 //+------------------------------------------------------------------+
 bool CExchangeSymbols::SymbolExists(LPCWSTR symbol)
   {
-   bool res=false;
 //--- lock
-   m_sync.Lock();
+   m_sync.LockRead();
 //--- search
-   for(uint32_t i=0;i<m_symbols.Total();i++)
-     {
-      //--- compare symbol names
-      if(CMTStr::Compare(m_symbols[i].symbol,symbol)==0)
-        {
-         res=true;
-         break;
-        }
-     }
+   bool res=SymbolPosition(symbol)>=0;
 //--- unlock
-   m_sync.Unlock();
+   m_sync.UnlockRead();
 //--- return result
    return(res);
   }
 //+------------------------------------------------------------------+
+//| Symbol position by name, -1 if not found                         |
+//+------------------------------------------------------------------+
+int32_t CExchangeSymbols::SymbolPosition(LPCWSTR symbol) const
+  {
+//--- not interned name is not in base
+   uint32_t id=CMTStrIntern::Global().Find(symbol);
+   if(id>=m_symbols_index.Total() || m_symbols_index[id]==0)
+      return(-1);
+//--- position
+   return(int32_t(m_symbols_index[id]-1));
+  }
+//+------------------------------------------------------------------+
 //| Copy symbol                                                      |
 //+------------------------------------------------------------------+
 void CExchangeSymbols::SymbolCopy(const ExchangeSymbol &source_symbol,ExchangeSymbol &dest_symbol)
@@ -18,8 +18,10 @@ private:
    CGateway         &m_gateway;
    //--- array of symbols
    ExchangeSymbolsArray m_symbols;
+   //--- symbol position+1 in array by symbol name ID
+   TMTArray<uint32_t,256> m_symbols_index;
    //--- lock on array of symbols
-   CMTSync           m_sync;
+   CMTSyncRW         m_sync;
 
 public:
    //--- constructor/destructor
@@ -41,6 +43,8 @@ public:
 private:
    //--- check if symbol exists in base (search by name)
    bool              SymbolExists(LPCWSTR symbol);
+   //--- symbol position by name, -1 if not found
+   int32_t           SymbolPosition(LPCWSTR symbol) const;
    //--- copy symbol
    void              SymbolCopy(const ExchangeSymbol &source_symbol,ExchangeSymbol &dest_symbol);
   };
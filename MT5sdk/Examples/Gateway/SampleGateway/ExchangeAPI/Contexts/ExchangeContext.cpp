@@ -749,7 +749,7 @@ bool CExchangeContext::SendCheck(bool &data_processed)
    if(m_buffer_send_tmp.Len()>0)
      {
       //--- if data are already sent, set flag of data processing
-      if(res=m_socket->Send(m_buffer_send_tmp.Buffer(),m_buffer_send_tmp.Len()))
+      if(res=m_socket->Send(m_buffer_send_tmp))
         {
          //--- set flag
          data_processed=true;
@@ -60,8 +60,8 @@ private:
    wchar_t           m_login[64];
    wchar_t           m_password[64];
    //--- buffers of packets for sending
-   CMTMemPack        m_buffer_send;
-   CMTMemPack        m_buffer_send_tmp;
+   CMTMemPackChunked m_buffer_send;
+   CMTMemPackChunked m_buffer_send_tmp;
    //--- synchronizer of access to packets for sending
    CMTSync           m_buffer_send_sync;
    //--- buffer of receipt packets
@@ -13,7 +13,8 @@ private:
    //--- constants
    enum EnConstantsSocket
      {
-      DEFAULT_SOCKET_TIMEOUT=10000           // socket default timeout (msec)
+      DEFAULT_SOCKET_TIMEOUT=10000,          // socket default timeout (msec)
+      SEND_SEGMENTS_MAX     =64              // maximum segments per send call
      };
 
 private:
@@ -36,6 +37,7 @@ public:
    bool              Read(char *buf,const uint32_t buf_max,uint32_t &buf_readed);
    //--- send data
    bool              Send(const char *buf,const uint32_t buf_size);
+   bool              Send(const CMTMemPackChunked &pack);
    //--- manage socket operation mode (blocking/non blocking)
    void              SetBlocking(const bool blocking);
    //--- set error description
@@ -537,16 +537,16 @@ MTAPIRES CDealWeekReport::ChartColumnsAdd(IMTReportDashboardWidget &chart,const
 void CDealWeekReport::FillRecord(Record &record,const Section &section,double *in_out_delta_accum) const
   {
 //--- fill record by section
-   record.volume      =section.in.amount+section.out.amount;
-   record.in_volume   =section.in.amount;
-   record.out_volume  =section.out.amount;
-   record.in_amount   =section.in.profit;
+   record.volume      =m_currency.MoneyToDouble(section.in.amount+section.out.amount);
+   record.in_volume   =section.in.Amount(m_currency);
+   record.out_volume  =section.out.Amount(m_currency);
+   record.in_amount   =section.in.Profit(m_currency);
    record.in_count    =section.in.total;
    record.in_medium   =section.in.Medium(m_currency);
-   record.out_amount  =-section.out.profit;
+   record.out_amount  =-section.out.Profit(m_currency);
    record.out_count   =section.out.total;
    record.out_medium  =section.out.Medium(m_currency);
-   record.in_out_delta=section.InOutProfitDelta(in_out_delta_accum);
+   record.in_out_delta=section.InOutProfitDelta(m_currency,in_out_delta_accum);
    record.in_out_delta_accum=in_out_delta_accum ? *in_out_delta_accum : NAN;
   }
 //+------------------------------------------------------------------+
@@ -558,9 +558,9 @@ bool CDealWeekReport::FillRowTotal(RowTotal &row,const Section &section) const
    if(!section.in.total && !section.out.total)
       return(false);
 //--- fill record by section
-   row.volume     =section.in.amount+section.out.amount;
-   row.in_volume  =section.in.amount;
-   row.out_volume =section.out.amount;
+   row.volume     =m_currency.MoneyToDouble(section.in.amount+section.out.amount);
+   row.in_volume  =section.in.Amount(m_currency);
+   row.out_volume =section.out.Amount(m_currency);
    return(true);
   }
 //+------------------------------------------------------------------+
@@ -299,7 +299,7 @@ void CFtdSection::FillRecordSection(FtdSectionRecord &record,const Ftd *ftd) con
      {
       //--- fill section
       record.value   =ftd->Medium(m_currency);
-      record.amount  =ftd->amount;
+      record.amount  =ftd->Amount(m_currency);
       record.count   =ftd->total;
      }
    else
@@ -227,7 +227,7 @@ void CFtdTotalSection::FillRecordSection(FtdSectionRecord &record,const Ftd &ftd
   {
 //--- fill section
    record.value   =ftd.Medium(m_currency);
-   record.amount  =ftd.amount;
+   record.amount  =ftd.Amount(m_currency);
    record.count   =ftd.total;
   }
 //+------------------------------------------------------------------+
@@ -236,12 +236,12 @@ MTAPIRES CLtvDetailedSection::WriteSection(const uint32_t *pos)
    record.in_first_medium  =section->in_first.medium;
    record.in_first_time    =section->in_first_time;
    record.in_first_total   =section->in_first.total;
-   record.in_first_amount  =section->in_first.amount;
+   record.in_first_amount  =section->in_first.Amount(m_currency);
    record.in_total         =section->in.total;
-   record.in_amount        =section->in.amount;
+   record.in_amount        =section->in.Amount(m_currency);
    record.in_medium        =section->in.medium;
    record.out_total        =section->out.total;
-   record.out_amount       =section->out.amount;
+   record.out_amount       =section->out.Amount(m_currency);
    record.out_medium       =section->out.medium;
 //--- write data row
    return(m_api->TableRowWrite(&record,sizeof(record)));
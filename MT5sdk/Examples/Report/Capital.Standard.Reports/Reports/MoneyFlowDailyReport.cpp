@@ -135,13 +135,13 @@ MTAPIRES CMoneyFlowDaily::PrepareGraph(IMTDataset *data,const ReportColumn &colu
 void CMoneyFlowDaily::FillRecord(MoneyRecord &record,const Section &section,double *in_out_delta_accum) const
   {
 //--- fill record by section
-   record.in_amount  =section.in.amount;
+   record.in_amount  =section.in.Amount(m_currency);
    record.in_count   =section.in.total;
    record.in_medium  =section.in.Medium(m_currency);
-   record.out_amount =section.out.amount;
+   record.out_amount =section.out.Amount(m_currency);
    record.out_count  =section.out.total;
    record.out_medium =section.out.Medium(m_currency);
-   record.in_out_delta=section.InOutAmountDelta(in_out_delta_accum);
+   record.in_out_delta=section.InOutAmountDelta(m_currency,in_out_delta_accum);
    record.in_out_delta_accum=in_out_delta_accum ? *in_out_delta_accum : NAN;
   }
 //+------------------------------------------------------------------+
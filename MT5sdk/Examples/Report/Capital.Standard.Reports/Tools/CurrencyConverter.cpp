@@ -114,6 +114,20 @@ double CCurrencyConverter::MoneyNormalize(const double value) const
    return(SMTMath::PriceNormalize(value,m_currency_digits));
   }
 //+------------------------------------------------------------------+
+//| Fixed point money from double                                    | 
+//+------------------------------------------------------------------+
+MTMoney CCurrencyConverter::MoneyFromDouble(const double value) const
+  {
+   return(MTMoney::FromDouble(value,m_currency_digits));
+  }
+//+------------------------------------------------------------------+
+//| Fixed point money to double                                      | 
+//+------------------------------------------------------------------+
+double CCurrencyConverter::MoneyToDouble(const MTMoney &money) const
+  {
+   return(money.ToDouble(m_currency_digits));
+  }
+//+------------------------------------------------------------------+
 //| Update column currency                                           | 
 //+------------------------------------------------------------------+
 MTAPIRES CCurrencyConverter::UpdateColumn(IMTDatasetColumn &column) const
@@ -44,6 +44,9 @@ public:
    double            MoneyAdd(const double amount,const double value) const;
    //--- normalize money
    double            MoneyNormalize(const double value) const;
+   //--- fixed point money conversion
+   MTMoney           MoneyFromDouble(const double value) const;
+   double            MoneyToDouble(const MTMoney &money) const;
    //--- update column currency
    MTAPIRES          UpdateColumn(IMTDatasetColumn &column) const;
    //--- append currency to string
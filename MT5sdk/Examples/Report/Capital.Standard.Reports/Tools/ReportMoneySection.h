@@ -7,6 +7,7 @@
 #include "CurrencyConverter.h"
 //+------------------------------------------------------------------+
 //| Report money structure                                           |
+//| amount and profit are fixed point in the report currency digits  |
 //+------------------------------------------------------------------+
 struct ReportMoney
   {
@@ -22,13 +23,16 @@ struct ReportMoney
      };
    //--- fields
    uint32_t          total;                     // count
-   double            amount;                    // amount
+   MTMoney           amount;                    // amount
    double            medium;                    // medium
-   double            profit;                    // profit
+   MTMoney           profit;                    // profit
    //--- add deal
    void              DealAdd(const double value,const uint32_t count,const CCurrencyConverter &currency);
    //--- add deals with profit
    void              DealProfitAdd(const uint32_t count,const double value,const double prof,const CCurrencyConverter &currency);
+   //--- amount and profit values
+   double            Amount(const CCurrencyConverter &currency) const { return(currency.MoneyToDouble(amount)); }
+   double            Profit(const CCurrencyConverter &currency) const { return(currency.MoneyToDouble(profit)); }
    //--- calculate medium value
    double            Medium(const CCurrencyConverter &currency) const;
    void              CalculateMedium(const CCurrencyConverter &currency);
@@ -69,9 +73,9 @@ struct ReportSection
    //--- add money section structure
    void              Add(const ReportSection &section,const CCurrencyConverter &currency);
    //--- in-out amount delta calculation
-   double            InOutAmountDelta(double *delta_accumulated) const;
+   double            InOutAmountDelta(const CCurrencyConverter &currency,double *delta_accumulated) const;
    //--- in-out profit delta calculation
-   double            InOutProfitDelta(double *delta_accumulated) const;
+   double            InOutProfitDelta(const CCurrencyConverter &currency,double *delta_accumulated) const;
    //--- sort money section by in amount descending
    static int32_t    SortInAmountDesc(const void *left,const void *right);
    //--- sort money section by amount descending
@@ -82,7 +86,7 @@ struct ReportSection
 //+------------------------------------------------------------------+
 inline void ReportMoney::DealAdd(const double value,const uint32_t count,const CCurrencyConverter &currency)
   {
-   amount=currency.MoneyAdd(amount,value);
+   amount+=currency.MoneyFromDouble(value);
    total+=count;
   }
 //+------------------------------------------------------------------+
@@ -92,8 +96,8 @@ inline void ReportMoney::DealProfitAdd(const uint32_t count,const double value,c
   {
    if(!count)
       return;
-   amount=currency.MoneyAdd(amount,value);
-   profit=currency.MoneyAdd(profit,prof);
+   amount+=currency.MoneyFromDouble(value);
+   profit+=currency.MoneyFromDouble(prof);
    total+=count;
   }
 //+------------------------------------------------------------------+
@@ -105,7 +109,7 @@ inline double ReportMoney::Medium(const CCurrencyConverter &currency) const
    if(!total)
       return(0.);
 //--- return medium
-   return(currency.MoneyNormalize(amount/total));
+   return(currency.MoneyNormalize(currency.MoneyToDouble(amount)/total));
   }
 //+------------------------------------------------------------------+
 //| calculate medium value                                           |
@@ -120,7 +124,7 @@ inline void ReportMoney::CalculateMedium(const CCurrencyConverter &currency)
 //+------------------------------------------------------------------+
 inline void ReportMoney::Add(const ReportMoney &money,const CCurrencyConverter &currency)
   {
-   amount=currency.MoneyAdd(amount,money.amount);
+   amount+=money.amount;
    total+=money.total;
   }
 //+------------------------------------------------------------------+
@@ -183,7 +187,7 @@ inline void ReportSection::CalculateMedium(const CCurrencyConverter &currency)
    out      .CalculateMedium(currency);
 //--- calculatte deposit-withdrawal medium
    if(const uint32_t total=in.total+out.total)
-      in_out_medium=currency.MoneyNormalize((in.amount-out.amount)/total);
+      in_out_medium=currency.MoneyNormalize(currency.MoneyToDouble(in.amount-out.amount)/total);
   }
 //+------------------------------------------------------------------+
 //| add money section structure                                      |
@@ -196,18 +200,18 @@ inline void ReportSection::Add(const ReportSection &section,const CCurrencyConve
    out      .Add(section.out     ,currency);
 //--- calculate deposit-withdrawal medium
    if(const uint32_t total=in.total+out.total)
-      in_out_medium=currency.MoneyNormalize((in.amount-out.amount)/total);
+      in_out_medium=currency.MoneyNormalize(currency.MoneyToDouble(in.amount-out.amount)/total);
   }
 //+------------------------------------------------------------------+
 //| in-out amount delta calculation                                  |
 //+------------------------------------------------------------------+
-inline double ReportSection::InOutAmountDelta(double *delta_accumulated) const
+inline double ReportSection::InOutAmountDelta(const CCurrencyConverter &currency,double *delta_accumulated) const
   {
 //--- check empty section
    if(!in.total && !out.total)
       return(NAN);
 //--- delta
-   const double delta=in.amount-out.amount;
+   const double delta=currency.MoneyToDouble(in.amount-out.amount);
 //--- accumulate delta
    if(delta_accumulated)
      {
@@ -221,13 +225,13 @@ inline double ReportSection::InOutAmountDelta(double *delta_accumulated) const
 //+------------------------------------------------------------------+
 //| in-out profit delta calculation                                  |
 //+------------------------------------------------------------------+
-inline double ReportSection::InOutProfitDelta(double *delta_accumulated) const
+inline double ReportSection::InOutProfitDelta(const CCurrencyConverter &currency,double *delta_accumulated) const
   {
 //--- check empty section
    if(!in.total && !out.total)
       return(NAN);
 //--- delta
-   const double delta=in.profit+out.profit;
+   const double delta=currency.MoneyToDouble(in.profit+out.profit);
 //--- accumulate delta
    if(delta_accumulated)
      {
@@ -258,8 +262,8 @@ inline int32_t ReportSection::SortAmountDesc(const void *left,const void *right)
    const ReportSection *lft=*(const ReportSection* const*)left;
    const ReportSection *rgh=*(const ReportSection* const*)right;
 //--- amounts
-   const double l=lft->in.amount+lft->out.amount;
-   const double r=rgh->in.amount+rgh->out.amount;
+   const MTMoney l=lft->in.amount+lft->out.amount;
+   const MTMoney r=rgh->in.amount+rgh->out.amount;
 //--- compare amount
    if(l<r)
       return(1);
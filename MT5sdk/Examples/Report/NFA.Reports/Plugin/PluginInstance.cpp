@@ -8,7 +8,7 @@
 //+------------------------------------------------------------------+
 //| Constructor                                                      |
 //+------------------------------------------------------------------+
-CPluginInstance::CPluginInstance(void) : m_api(NULL),m_config(NULL),m_param(NULL),m_time(NULL)
+CPluginInstance::CPluginInstance(void) : m_sync(L"NFA.Reports"),m_api(NULL),m_config(NULL),m_param(NULL),m_time(NULL)
   {
   }
 //+------------------------------------------------------------------+
@@ -81,7 +81,7 @@ MTAPIRES CPluginInstance::Stop(void)
 //--- shutdown report thread
    m_reports.Shutdown();
 //--- shutdown databases
-   m_sync.Lock();
+   m_sync.LockWrite();
    m_sltp.Shutdown();
    m_requests.Clear();
 //--- unsubscribe 
@@ -96,7 +96,7 @@ MTAPIRES CPluginInstance::Stop(void)
    if(m_param)  { m_param->Release();  m_param =NULL; }
    if(m_time)   { m_time->Release();   m_time  =NULL; }
 //--- ok
-   m_sync.Unlock();
+   m_sync.UnlockWrite();
    return(MT_RET_OK);
   }
 //+------------------------------------------------------------------+
@@ -104,19 +104,19 @@ MTAPIRES CPluginInstance::Stop(void)
 //+------------------------------------------------------------------+
 void CPluginInstance::CheckCloseDay(const tm &ttm_batch)
   {
-   m_sync.Lock();
+   m_sync.LockWrite();
    m_orders.CloseDay(ttm_batch);
    m_trades.CloseDay(ttm_batch);
-   m_sync.Unlock();
+   m_sync.UnlockWrite();
   }
 //+------------------------------------------------------------------+
 //| Compact process. Thread-safe                                     |
 //+------------------------------------------------------------------+
 void CPluginInstance::CompactProcess(void)
   {
-   m_sync.Lock();
+   m_sync.LockWrite();
    m_sltp.Compact();
-   m_sync.Unlock();
+   m_sync.UnlockWrite();
   }
 //+------------------------------------------------------------------+
 //| Plugin parameters read function                                  |
@@ -132,7 +132,7 @@ void CPluginInstance::OnPluginUpdate(const IMTConPlugin *plugin)
 //--- shutdown report thread
    m_reports.Shutdown();
 //--- shutdown workers
-   m_sync.Lock();
+   m_sync.LockWrite();
    m_sltp.Shutdown();
 //--- read params
    ReadParams();
@@ -140,7 +140,7 @@ void CPluginInstance::OnPluginUpdate(const IMTConPlugin *plugin)
    m_reports.Initialize(this,m_api,m_context);
    m_sltp.Initialize(m_api,m_context);
 //--- unlock
-   m_sync.Unlock();
+   m_sync.UnlockWrite();
   }
 //+------------------------------------------------------------------+
 //| Server API event                                                 |
@@ -160,9 +160,9 @@ void CPluginInstance::OnTradeRequestAdd(const IMTRequest *request,const IMTConGr
       case IMTRequest::TA_ACTIVATE_STOPLIMIT:
       case IMTRequest::TA_DEALER_ORD_ACTIVATE:
          rec_order.FillPending(CNFAOrderRecord::TRANS_UNDEFINED,order,CNFAOrderRecord::ORIGIN_AUTO);
-         m_sync.Lock();
+         m_sync.LockWrite();
          m_requests.Add(request->ID(),rec_order);
-         m_sync.Unlock();
+         m_sync.UnlockWrite();
          break;
       default:
          return;
@@ -184,7 +184,7 @@ void CPluginInstance::OnTradeRequestProcess(const IMTRequest *request,const IMTC
 //--- get time
    int64_t time_server=m_api->TimeCurrent(),time_add=order ? order->TimeSetup() : 0,time_process=deal ? deal->Time() : 0;
 //--- lock
-   m_sync.Lock();
+   m_sync.LockWrite();
 //--- parse actions
    switch(request->Action())
      {
@@ -292,7 +292,7 @@ void CPluginInstance::OnTradeRequestProcess(const IMTRequest *request,const IMTC
            }
          break;
       default:
-         m_sync.Unlock();
+         m_sync.UnlockWrite();
          return;
      }
 //--- prepare time setup for order
@@ -318,7 +318,7 @@ void CPluginInstance::OnTradeRequestProcess(const IMTRequest *request,const IMTC
    WriteOrder(rec_tp,ttm_batch,ttm_stamp);
    WriteTrade(rec_trade,ttm_batch,ttm_stamp);
 //--- unlock
-   m_sync.Unlock();
+   m_sync.UnlockWrite();
   }
 //+------------------------------------------------------------------+
 //| Server API event                                                 |
@@ -336,7 +336,7 @@ void CPluginInstance::OnTradeExecution(const IMTConGateway *gateway,const IMTExe
 //--- get time
    int64_t time_process=deal ? deal->Time() : m_api->TimeCurrent();
 //---
-   m_sync.Lock();
+   m_sync.LockWrite();
 //--- check action
    switch(execution->Action())
      {
@@ -384,7 +384,7 @@ void CPluginInstance::OnTradeExecution(const IMTConGateway *gateway,const IMTExe
          rec_order.FillPending(CNFAOrderRecord::TRANS_ORDER_CANCELLED,order,CNFAOrderRecord::ORIGIN_AUTO);
          break;
       default:
-         m_sync.Unlock();
+         m_sync.UnlockWrite();
          return;
      }
 //--- prepare execution time
@@ -405,7 +405,7 @@ void CPluginInstance::OnTradeExecution(const IMTConGateway *gateway,const IMTExe
    WriteOrder(rec_tp,ttm_batch,ttm_stamp);
    WriteTrade(rec_trade,ttm_batch,ttm_stamp);
 //--- unlock
-   m_sync.Unlock();
+   m_sync.UnlockWrite();
   }
 //+------------------------------------------------------------------+
 //| Server API event                                                 |
@@ -416,9 +416,9 @@ void CPluginInstance::OnTradeRequestDelete(const IMTRequest *request)
       return;
 //--- find initial request
    CNFAOrderRecord rec_order={};
-   m_sync.Lock();
+   m_sync.LockWrite();
    bool req_exist=m_requests.Remove(request->ID(),rec_order);
-   m_sync.Unlock();
+   m_sync.UnlockWrite();
    if(!req_exist)
       return;
 //--- check
@@ -449,9 +449,9 @@ void CPluginInstance::OnTradeRequestDelete(const IMTRequest *request)
    PrepareTimes(m_api->TimeCurrent(),ttm_batch,ttm_stamp);
    rec_order.SetBidAsk(request);
 //--- writing synchronized
-   m_sync.Lock();
+   m_sync.LockWrite();
    WriteOrder(rec_order,ttm_batch,ttm_stamp);
-   m_sync.Unlock();
+   m_sync.UnlockWrite();
   }
 //+------------------------------------------------------------------+
 //| Server API event                                                 |
@@ -484,9 +484,9 @@ void CPluginInstance::OnTradeRequestRefuse(const IMTRequest *request)
    PrepareTimes(m_api->TimeCurrent(),ttm_batch,ttm_stamp);
    rec_order.SetBidAsk(request);
 //--- write
-   m_sync.Lock();
+   m_sync.LockWrite();
    WriteOrder(rec_order,ttm_batch,ttm_stamp);
-   m_sync.Unlock();
+   m_sync.UnlockWrite();
   }
 //+------------------------------------------------------------------+
 //| Process market order                                             |
@@ -822,9 +822,9 @@ bool CPluginInstance::CheckGroupAndSymbol(LPCWSTR group,LPCWSTR symbol)
    bool res=false;
    if(group && symbol)
      {
-      m_sync.Lock();
-      res=CMTStr::CheckGroupMask(m_context.groups.Str(),group) && CMTStr::CheckGroupMask(m_context.symbols.Str(),symbol);
-      m_sync.Unlock();
+      m_sync.LockRead();
+      res=m_groups_mask.Check(group) && m_symbols_mask.Check(symbol);
+      m_sync.UnlockRead();
      }
    return(res);
   }
@@ -876,6 +876,9 @@ MTAPIRES CPluginInstance::ReadParams(void)
    if(!ParamGetString (L"SFTP Private Key Path" ,m_context.sftp_key_path   ,DEFAULT_SFTP_KEY_PATH )) return(MT_RET_ERR_PARAMS);
    if(!ParamGetTime   (L"Report Time"           ,m_context.report_time     ,DEFAULT_REPORT_TIME   )) return(MT_RET_ERR_PARAMS);
    if(!ParamGetTime   (L"Send Time"             ,m_context.send_time       ,DEFAULT_SEND_TIME     )) return(MT_RET_ERR_PARAMS);
+//--- compile masks
+   if(!m_groups_mask.Compile(m_context.groups.Str(),MASK_CACHE_SIZE) || !m_symbols_mask.Compile(m_context.symbols.Str(),MASK_CACHE_SIZE))
+      return(MT_RET_ERR_MEM);
 //--- cache timezone
    m_context.server_timezone=m_time->TimeZone();
 //--- get server path
@@ -26,6 +26,7 @@
 #define DEFAULT_SFTP_KEY_PATH L""
 #define DEFAULT_REPORT_TIME   L"17:00:00"
 #define DEFAULT_SEND_TIME     L"18:00:00"
+#define MASK_CACHE_SIZE       1024
 //+------------------------------------------------------------------+
 //| Plugin instance class                                            |
 //+------------------------------------------------------------------+
@@ -36,7 +37,7 @@ class CPluginInstance : public IMTServerPlugin,
   {
 private:
    //---
-   CMTSync           m_sync;
+   CMTSyncRW         m_sync;
    IMTServerAPI     *m_api;
    //--- plugin config interface
    IMTConPlugin     *m_config;
@@ -44,6 +45,8 @@ private:
    IMTConTime       *m_time;
    //--- plugin context
    PluginContext     m_context;
+   CMTGroupMask      m_groups_mask;
+   CMTGroupMask      m_symbols_mask;
    //--- databases
    CTextBaseWriter   m_orders;
    CTextBaseWriter   m_trades;
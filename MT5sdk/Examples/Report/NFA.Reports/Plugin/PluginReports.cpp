@@ -264,7 +264,15 @@ bool CPluginReports::FileReportWrite(CMTFile &file,LPCWSTR line)
    CMTStr::Copy(m_buffer,sizeof(m_buffer),line);
    m_buffer[sizeof(m_buffer)-1]=0;
 //--- write to file
-   if(!file.Write(m_buffer,(DWORD)strlen(m_buffer)))
+   return(FileReportWrite(file,m_buffer,(uint32_t)strlen(m_buffer)));
+  }
+//+------------------------------------------------------------------+
+//| Put ANSI line to file                                            |
+//+------------------------------------------------------------------+
+bool CPluginReports::FileReportWrite(CMTFile &file,LPCSTR line,const uint32_t len)
+  {
+//--- write to file
+   if(!file.Write(line,(DWORD)len))
      {
       Out(MTLogErr,L"write report error [%u]",GetLastError());
       return(false);
@@ -416,7 +424,8 @@ void CPluginReports::MakeReportTick(const tm &batch_ttm,CMTStr &batch_str,const
    IMTConSymbol *symbol=NULL;
    if((symbol=m_api->SymbolCreate())!=NULL)
      {
-      CMTStr64 sdatetime,sbid,sask;
+      wchar_t prefix[128];
+      char    line[512],*line_tick;
       //--- iterate over all symbols
       for(uint32_t pos=0;m_api->SymbolNext(pos,symbol)==MT_RET_OK && m_workflag;pos++)
         {
@@ -430,34 +439,33 @@ void CPluginReports::MakeReportTick(const tm &batch_ttm,CMTStr &batch_str,const
          uint32_t     ticks_total=0;
          if(m_api->TickHistoryGet(symbol->Symbol(),req_from,req_to,ticks,ticks_total)==MT_RET_OK && ticks!=NULL)
            {
+            //--- FDM_ID|BATCH_DATE|PRODUCT_CODE| are the same for all ticks of symbol
+            wchar_t *cp=SMTFormatFast::Copy(prefix,m_context.fdm_id.Str());
+            cp=SMTFormatFast::Char(cp,L'|');
+            cp=SMTFormatFast::Copy(cp,batch_str.Str());
+            cp=SMTFormatFast::Char(cp,L'|');
+            cp=SMTFormatFast::Copy(cp,symbol->Symbol());
+            cp=SMTFormatFast::Char(cp,L'|');
+            CMTStr::Copy(line,sizeof(line)-SMTFormatFast::DATE_LEN_MAX-2*SMTFormatFast::NUMBER_LEN_MAX-8,prefix);
+            line_tick=line+strlen(line);
             //--- iterate over all ticks
             for(uint32_t i=0;i<ticks_total;i++)
               {
                //--- prepare
                const MTTickShort &tick=ticks[i];
                tm                 tick_ttm={};
-               //--- format time
+               //--- time
                SMTTime::ParseTime(tick.datetime,&tick_ttm);
                SPluginHelpers::TimeToEST(tick_ttm,m_context.server_timezone);
-               SPluginHelpers::FormatStampDatetime(sdatetime,tick_ttm);
-               //--- format bid & ask
-               SMTFormat::FormatDouble(sbid,tick.bid,digits);
-               SMTFormat::FormatDouble(sask,tick.ask,digits);
-               //--- format
-               m_buffer_line.Format(L"%s|"        // FDM_ID
-                                     "%s|"        // BATCH_DATE
-                                     "%s|"        // PRODUCT_CODE
-                                     "%s|"        // QUOTE_DATETIME
-                                     "%s|"        // BID_PRICE
-                                     "%s\r\n",    // ASK_PRICE
-                  m_context.fdm_id.Str(),
-                  batch_str.Str(),
-                  symbol->Symbol(),
-                  sdatetime.Str(),
-                  sbid.Str(),
-                  sask.Str());
+               //--- format QUOTE_DATETIME|BID_PRICE|ASK_PRICE directly to line
+               char *lp=SMTFormatFast::DateTime(line_tick,tick_ttm,true,'-');
+               lp=SMTFormatFast::Char(lp,'|');
+               lp=SMTFormatFast::Price(lp,tick.bid,digits);
+               lp=SMTFormatFast::Char(lp,'|');
+               lp=SMTFormatFast::Price(lp,tick.ask,digits);
+               lp=SMTFormatFast::Copy(lp,"\r\n");
                //--- write
-               FileReportWrite(file,m_buffer_line.Str());
+               FileReportWrite(file,line,uint32_t(lp-line));
               }
            }
          //--- cleanup
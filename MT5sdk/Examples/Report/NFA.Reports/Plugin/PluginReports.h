@@ -48,6 +48,7 @@ private:
    //--- report writing helpers
    bool              FileReportOpen(CMTFile &file,LPCWSTR path,LPCSTR header);
    bool              FileReportWrite(CMTFile &file,LPCWSTR line);
+   bool              FileReportWrite(CMTFile &file,LPCSTR line,const uint32_t len);
    //--- report generating
    void              MakeReports(const tm &batch_ttm);
    bool              MakeReportCompress(const tm &batch_ttm,LPCWSTR name,LPCWSTR report_dir);
@@ -77,7 +77,8 @@ bool CSLTPBase::IndexRebuild(void)
       m_index_position.Add(&rec);
       rec=Next(rec);
      }
-   m_index_position.Sort(SortByPosition);
+//--- descending order of SortByPosition by inverted position id
+   SMTSearch::RadixSort(m_index_position.First(),m_index_position.Total(),[](const SLTPRecord *record) { return(~record->position_id); });
    return(true);
   }
 //+------------------------------------------------------------------+
@@ -88,7 +88,7 @@ CTradeTransactionReport::CTradeTransactionReport(void) : m_api(NULL),m_show_owne
   {
    m_base.Close();
    m_logins.Clear();
-   m_symbol_mask.Clear();
+   m_symbol_mask.Shutdown();
   }
 //+------------------------------------------------------------------+
 //| Destructor                                                       |
@@ -111,7 +111,7 @@ void CTradeTransactionReport::Clear(void)
 //--- clear all
    m_base.Close();
    m_logins.Clear();
-   m_symbol_mask.Clear();
+   m_symbol_mask.Shutdown();
   }
 //+------------------------------------------------------------------+
 //| Report generation                                                |
@@ -197,19 +197,20 @@ MTAPIRES CTradeTransactionReport::Generate(const uint32_t type,IMTReportAPI *api
 //--- release interfaces
    report->Release();    report   =NULL;
    parameter->Release(); parameter=NULL;
-//--- get symbol mask
-   m_symbol_mask.Assign(m_api->ParamSymbols());
-   if(m_symbol_mask.Empty())
+//--- get symbol mask and compile it with cache for symbols and paths
+   LPCWSTR symbols=m_api->ParamSymbols();
+   if(!symbols || !*symbols)
       return(MT_RET_ERR_PARAMS);
+   if(!m_symbol_mask.Compile(symbols,SYMBOLS_CACHE))
+      return(MT_RET_ERR_MEM);
 //--- get logins parameter
    if((res=m_api->ParamLogins(logins,total))!=MT_RET_OK)
       return(res);
    if(!total)
       return(MT_RET_ERR_PARAMS);
-//--- add to array and sort it
+//--- add to set
    if(!m_logins.Add(logins,total))
-      return(MT_RET_ERR_PARAMS);
-   m_logins.Sort(SortLogins);
+      return(MT_RET_ERR_MEM);
 //--- initialize base reader
    if(!m_base.Initialize(path,nullptr))
       return(MT_RET_ERR_PARAMS);
@@ -315,7 +316,7 @@ MTAPIRES CTradeTransactionReport::TableWrite(void)
                db_record.retcode!=MT_RET_REQUEST_PLACED)
                continue;
          //--- login filter
-         if(m_logins.Search(&db_record.login,SortLogins)==NULL)
+         if(!m_logins.Contains(db_record.login))
             continue;
          //--- symbol filter (deposit transactions haven't symbol)
          if(db_record.action!=TransactionRecord::ACTION_DEPOSIT)
@@ -327,8 +328,7 @@ MTAPIRES CTradeTransactionReport::TableWrite(void)
                continue;
               }
             //--- check mask
-            if(!CMTStr::CheckGroupMask(m_symbol_mask.Str(),symbol->Symbol()) &&
-               !CMTStr::CheckGroupMask(m_symbol_mask.Str(),symbol->Path()))
+            if(!m_symbol_mask.Check(symbol->Symbol()) && !m_symbol_mask.Check(symbol->Path()))
                continue;
             //---
             if(!db_record.digits)
@@ -486,17 +486,4 @@ LPCWSTR CTradeTransactionReport::PrintReason(const uint32_t reason)
 //---
    return(L"");
   }
-//+------------------------------------------------------------------+
-//| Sort logins                                                      |
-//+------------------------------------------------------------------+
-int32_t CTradeTransactionReport::SortLogins(const void *left,const void *right)
-  {
-   uint64_t lft=*(uint64_t*)left;
-   uint64_t rgh=*(uint64_t*)right;
-//--- by logins
-   if(lft>rgh) return(-1);
-   if(lft<rgh) return(1);
-//--- equal
-   return(0);
-  }
 //+------------------------------------------------------------------+
\ No newline at end of file
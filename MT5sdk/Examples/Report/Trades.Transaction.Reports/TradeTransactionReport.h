@@ -15,6 +15,7 @@ private:
    enum EnConstants
      {
       RATE_DIGITS            =8,   // digits for rate
+      SYMBOLS_CACHE          =1024,// symbol mask results cache size
      };
    //--- column ids
    enum columns
@@ -165,8 +166,6 @@ private:
         }
      };
    #pragma pack(pop)
-   //---
-   typedef TMTArray<uint64_t> LoginsArray;
 private:
    //--- table record
    static MTReportInfo s_info;                  // report information     
@@ -174,9 +173,9 @@ private:
    //--- api
    IMTReportAPI*     m_api;                     // api interface
    CTransactionBase  m_base;                    // base of transactions
-   LoginsArray       m_logins;                  // array of logins
+   CMTLoginSet       m_logins;                  // set of logins
    //--- configs
-   CMTStr32          m_symbol_mask;             // symbol mask
+   CMTGroupMask      m_symbol_mask;             // compiled symbol mask
    bool              m_show_owner;              // show owner flag
    bool              m_show_daily;              // show daily transactions
    bool              m_show_reason;             // show reason
@@ -204,7 +203,5 @@ private:
    //--- table management
    MTAPIRES          TablePrepare(void);
    MTAPIRES          TableWrite(void);
-   //--- search functions
-   static int32_t    SortLogins(const void *left,const void *right);
   };
 //+------------------------------------------------------------------+
@@ -12,9 +12,11 @@ CTransactionBase::CTransactionBase(void)
    : m_api(NULL),
      m_file_size(0),
      m_timestamp(0),
-     m_income_event(NULL),
-     m_thread_exit(NULL),
-     m_standby_event(NULL)
+     m_overflow_used(0),
+     m_overflow_pushed(0),
+     m_written(0),
+     m_thread_started(0),
+     m_thread_stop(0)
   {
    m_path.Clear();
   }
@@ -206,19 +208,17 @@ bool CTransactionBase::Initialize(CMTStr& path,IMTServerAPI *api)
 bool CTransactionBase::Write(const TransactionRecord& record)
   {
 //--- initializing thread for writing to file
-   if(!Start() || !m_income_event)
+   if(!Start())
      {
       //--- writing record directly to file
       return(WriteRecord(record));
      }
-//--- trying to add record to array
+//--- trying to add record to queue
    if(!PushRecord(record))
      {
       //--- stop operation, otherwise writing directly to file violates chronology
       return(false);
      }
-//--- set prepared array processing signal
-   SetEvent(m_income_event);
 //--- ok
    return(true);
   }
@@ -479,37 +479,65 @@ void CTransactionBase::ConvertBase101(TransactionRecord& record)
    record.lots=SMTMath::VolumeExtFromVolume(record.lots);
   }
 //+------------------------------------------------------------------+
-//| Adding record to writing to file array                           |
+//| Adding record to writing to file queue                           |
+//| the queue is lock free, hook thread never waits for the writer,  |
+//| records of the full queue go to the overflow array               |
 //+------------------------------------------------------------------+
 inline bool CTransactionBase::PushRecord(const TransactionRecord& record)
   {
+//--- writer is stopping, the record would not be written
+   if(m_thread_stop)
+      return(false);
+//--- lock free queue while there is no overflow
+   if(!m_overflow_used && m_income.Push(record))
+      return(true);
+//--- queue is full or records are already in the overflow
+   return(PushOverflow(record));
+  }
+//+------------------------------------------------------------------+
+//| Adding record to overflow array                                  |
+//+------------------------------------------------------------------+
+bool CTransactionBase::PushOverflow(const TransactionRecord& record)
+  {
+   bool res=true;
 //--- under lock
-   m_income_sync.Lock();
-//--- trying to add record to array
-   if(!m_income.Add(&record))
+   m_overflow_sync.Lock();
+//--- overflow has been taken by writer meanwhile, try the queue again
+   if(!m_overflow_used && m_income.Push(record))
      {
-      m_income_sync.Unlock();
-      return(false);
+      m_overflow_sync.Unlock();
+      return(true);
      }
-//--- reset standby event
-   if(m_standby_event)
-      ResetEvent(m_standby_event);
-//--- ok
-   m_income_sync.Unlock();
-   return(true);
+//--- add record after all queued ones
+   if(m_overflow.Add(&record))
+     {
+      InterlockedExchange(&m_overflow_used,1);
+      InterlockedIncrement64(&m_overflow_pushed);
+     }
+   else
+      res=false;
+   m_overflow_sync.Unlock();
+//--- wake writer
+   if(res)
+      m_income.Wake();
+   return(res);
   }
 //+------------------------------------------------------------------+
-//| Extracting records array for writing to file                     |
+//| Take overflow records, the queue must be drained before          |
 //+------------------------------------------------------------------+
-inline void CTransactionBase::PopRecords(RecordArray& records)
+bool CTransactionBase::PopOverflow(RecordArray& records)
   {
-//--- preparing array
    records.Clear();
-//--- under lock
-   m_income_sync.Lock();
-//--- extracting records
-   records.Swap(m_income);
-   m_income_sync.Unlock();
+//--- check
+   if(!m_overflow_used)
+      return(false);
+//--- swap under lock, next records go to the queue again
+   m_overflow_sync.Lock();
+   records.Swap(m_overflow);
+   InterlockedExchange(&m_overflow_used,0);
+   m_overflow_sync.Unlock();
+//--- ok
+   return(records.Total()>0);
   }
 //+------------------------------------------------------------------+
 //| Start thread of records processing                               |
@@ -528,41 +556,63 @@ uint32_t CTransactionBase::ProcessWrapper(LPVOID param)
 //+------------------------------------------------------------------+
 void CTransactionBase::Process(void)
   {
-   RecordArray records;
-   HANDLE      events[]={ m_income_event,m_thread_exit };
-   while(WaitForMultipleObjects(_countof(events),events,FALSE,INFINITE)==WAIT_OBJECT_0)
+   TransactionRecord records[RECORDS_BATCH];
+   RecordArray       overflow;
+   for(;;)
      {
-      //--- reset thread standy event
-      if(m_standby_event)
-         ResetEvent(m_standby_event);
       //--- pop and write records
-      PopRecords(records);
-      for(uint32_t i=0;i<records.Total();i++)
+      if(const uint32_t total=m_income.PopBatch(records,_countof(records)))
         {
-         WriteRecord(records[i]);
+         for(uint32_t i=0;i<total;i++)
+           {
+            WriteRecord(records[i]);
+           }
+         //--- notify standby waiters
+         InterlockedExchangeAdd64(&m_written,total);
+         m_written_event.Notify();
+         continue;
         }
-      //--- set thread standy event
-      if(m_standby_event)
+      //--- queue is drained including reserved cells, write overflow records pushed after the queued ones
+      if(m_income.Empty() && PopOverflow(overflow))
         {
-         //--- under lock
-         m_income_sync.Lock();
-         //--- set stanby event on empty queque
-         if(!m_income.Total())
-            SetEvent(m_standby_event);
-         m_income_sync.Unlock();
+         for(uint32_t i=0;i<overflow.Total();i++)
+           {
+            WriteRecord(overflow[i]);
+           }
+         InterlockedExchangeAdd64(&m_written,overflow.Total());
+         m_written_event.Notify();
+         continue;
         }
+      //--- queue is drained, check completion
+      if(m_thread_stop && m_income.Empty() && !m_overflow_used)
+         break;
+      //--- wait for records
+      m_income.Wait();
      }
   }
 //+------------------------------------------------------------------+
 //| Wait for records processing thread standby                       |
+//| all records pushed before the call must be written               |
 //+------------------------------------------------------------------+
 bool CTransactionBase::WaitStandby(const uint32_t timeout)
   {
-   if(!m_standby_event)
-      return(true);
-//--- wait for processing thread standby
-   if(WaitForSingleObject(m_standby_event,timeout)!=WAIT_OBJECT_0)
-      return(false);
+   const uint64_t pushed=m_income.Pushed()+uint64_t(m_overflow_pushed);
+   const uint64_t start =GetTickCount64();
+//--- wait for processing thread to write records
+   while(uint64_t(m_written)<pushed)
+     {
+      const uint64_t elapsed=GetTickCount64()-start;
+      if(elapsed>=timeout)
+         return(false);
+      //--- recheck after wait preparation to not lose notification
+      const LONG epoch=m_written_event.PrepareWait();
+      if(uint64_t(m_written)>=pushed)
+        {
+         m_written_event.CancelWait();
+         break;
+        }
+      m_written_event.Wait(epoch,DWORD(timeout-elapsed));
+     }
 //--- flush file
    if(m_file.IsOpen())
       m_file.Flush();
@@ -573,23 +623,32 @@ bool CTransactionBase::WaitStandby(const uint32_t timeout)
 //+------------------------------------------------------------------+
 bool CTransactionBase::Start(void)
   {
-//--- reset forced thread completion signal
-   if(m_thread_exit)
-      ResetEvent(m_thread_exit);
-   else if((m_thread_exit=CreateEvent(NULL,TRUE,FALSE,NULL))==NULL)
-         return(false);
-//--- prepare array processing signal with records
-   if(m_income_event==NULL)
-      if((m_income_event=CreateEvent(NULL,FALSE,FALSE,NULL))==NULL)
-         return(false);
-//--- create thread standby event
-   if(m_standby_event==NULL)
-      if((m_standby_event=CreateEvent(NULL,TRUE,TRUE,NULL))==NULL)
+//--- thread is already started
+   if(m_thread_started)
+      return(true);
+//--- under lock
+   m_thread_sync.Lock();
+   if(!m_thread_started)
+     {
+      //--- allocate queue
+      if(!m_income.Initialize(INCOME_QUEUE_SIZE))
+        {
+         m_thread_sync.Unlock();
          return(false);
-//--- launching thread
-   if(!m_thread.IsBusy())
+        }
+      m_written        =0;
+      m_overflow_pushed=0;
+      m_thread_stop    =0;
+      //--- launching thread
       if(!m_thread.Start(ProcessWrapper,this,0))
+        {
+         m_income.Shutdown();
+         m_thread_sync.Unlock();
          return(false);
+        }
+      InterlockedExchange(&m_thread_started,1);
+     }
+   m_thread_sync.Unlock();
 //--- ok
    return(true);
   }
@@ -598,29 +657,23 @@ bool CTransactionBase::Start(void)
 //+------------------------------------------------------------------+
 void CTransactionBase::Shutdown(void)
   {
-//--- set forced thread completion signal
-   if(m_thread_exit)
-      SetEvent(m_thread_exit);
+//--- under lock
+   m_thread_sync.Lock();
+//--- set forced thread completion signal, queue is drained before completion
+   InterlockedExchange(&m_thread_stop,1);
+   m_income.Wake();
 //--- waiting thread completion
    m_thread.Shutdown();
-//--- close forced thread completion signal
-   if(m_thread_exit)
-     {
-      CloseHandle(m_thread_exit);
-      m_thread_exit=NULL;
-     }
-//--- close prepared array processing signal
-   if(m_income_event)
-     {
-      CloseHandle(m_income_event);
-      m_income_event=NULL;
-     }
-//--- close thread standby event
-   if(m_standby_event)
-     {
-      CloseHandle(m_standby_event);
-      m_standby_event=NULL;
-     }
+//--- free queue
+   InterlockedExchange(&m_thread_started,0);
+   m_income.Shutdown();
+   m_overflow_sync.Lock();
+   m_overflow.Shutdown();
+   m_overflow_used  =0;
+   m_overflow_pushed=0;
+   m_overflow_sync.Unlock();
+   m_written        =0;
+   m_thread_sync.Unlock();
 //--- clear server API interface
    m_api=NULL;
   }
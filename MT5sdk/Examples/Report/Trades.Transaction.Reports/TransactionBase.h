@@ -180,12 +180,14 @@ class CTransactionBase
   {
 private:
    //--- special type
-   typedef TMTArray<const TransactionRecord,128> RecordArray;
+   typedef TMTArray<TransactionRecord,128> RecordArray;
    //--- constants
    enum constants
      {
       FILE_STEP_SIZE   =4*MB,
       FILE_DELTA_RESIZE=64*KB,
+      INCOME_QUEUE_SIZE=8192,                // records queue capacity
+      RECORDS_BATCH    =16,                  // records popped at once
      };
    //--- server API interface
    IMTServerAPI     *m_api;
@@ -194,14 +196,19 @@ private:
    uint64_t          m_file_size;
    int64_t           m_timestamp;
    CMTSync           m_file_sync;
-   //--- cache of records
-   RecordArray       m_income;
-   CMTSync           m_income_sync;
-   HANDLE            m_income_event;
+   //--- queue of records
+   TMTQueueMPSC<TransactionRecord> m_income;
+   RecordArray       m_overflow;             // records after the queue overflow, written after the queue
+   CMTSync           m_overflow_sync;
+   volatile LONG     m_overflow_used;        // overflow is not empty, records go to it to keep order
+   volatile LONG64   m_overflow_pushed;      // records pushed to overflow
+   volatile LONG64   m_written;
+   CMTEventCount     m_written_event;
    //--- thread of records processing
    CMTThread         m_thread;
-   HANDLE            m_thread_exit;
-   HANDLE            m_standby_event;
+   CMTSync           m_thread_sync;
+   volatile LONG     m_thread_started;
+   volatile LONG     m_thread_stop;
    //--- 
    CMTStrPath        m_path;
 
@@ -230,9 +237,10 @@ private:
    bool              ConvertBase(const int64_t timestamp);
    void              ConvertBase100(TransactionRecord& record);
    void              ConvertBase101(TransactionRecord& record);
-   //--- cache of records
+   //--- queue of records
    bool              PushRecord(const TransactionRecord& record);
-   void              PopRecords(RecordArray& records);
+   bool              PushOverflow(const TransactionRecord& record);
+   bool              PopOverflow(RecordArray& records);
    //--- thread of records processing
    static uint32_t __stdcall ProcessWrapper(LPVOID param);
    void              Process(void);
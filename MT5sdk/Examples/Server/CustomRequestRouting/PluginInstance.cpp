@@ -76,25 +76,20 @@ MTAPIRES CPluginInstance::HookTradeRequestRuleFilter(IMTRequest* request,IMTConR
       request->Action()==IMTRequest::TA_EXCHANGE)
       if(request->Type()==IMTOrder::OP_BUY)
         {
-         uint32_t   i;
          uint64_t ticket=request->Order();
-         //--- has it cleared already?
-         for(i=0;i<m_cleared.Total();i++)
-            if(m_cleared[i]==ticket)
-               break;
-         //--- No?
-         if(i>=m_cleared.Total())
+         //--- has it cleared already? No?
+         if(!m_cleared.Contains(ticket))
            {
             rule->Clear();
             rule->Name(L"plugin removes SL and TP from market buy");
             rule->Action(IMTConRoute::ACTION_CLEAR_SLTP);
             //--- remember cleared 
-            m_cleared.Add(&ticket);
+            m_cleared.Add(ticket);
             //--- we want to add custom action
             return(MT_RET_OK);
            }
          //--- remove cleared buy 
-         m_cleared.Delete(i);
+         m_cleared.Remove(ticket);
          //--- lets confirm it by market price
          rule->Clear();
          rule->Name(L"plugin confirms market buy by market");
@@ -124,25 +119,20 @@ MTAPIRES CPluginInstance::HookTradeRequestRuleApply(IMTRequest*  request,IMTConR
          if(rule->Action()==IMTConRoute::ACTION_CONFIRM_MARKET ||
             rule->Action()==IMTConRoute::ACTION_CONFIRM_CLIENT)
            {
-            uint32_t   i;
             uint64_t ticket=request->Order();
-            //--- has it cleared already?
-            for(i=0;i<m_cleared.Total();i++)
-               if(m_cleared[i]==ticket)
-                  break;
-            //--- No?
-            if(i>=m_cleared.Total())
+            //--- has it cleared already? No?
+            if(!m_cleared.Contains(ticket))
               {
                rule->Clear();
                rule->Name(L"plugin removes SL and TP from market sell");
                rule->Action(IMTConRoute::ACTION_CLEAR_SLTP);
                //--- remember cleared 
-               m_cleared.Add(&ticket);
+               m_cleared.Add(ticket);
                //--- we want to add custom action
                return(MT_RET_OK);
               }
             //--- remove cleared buy 
-            m_cleared.Delete(i);
+            m_cleared.Remove(ticket);
             //--- we want to use current rule from table
             return(MT_RET_OK_NONE);
            }
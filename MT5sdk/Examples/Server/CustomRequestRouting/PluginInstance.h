@@ -13,7 +13,7 @@ class CPluginInstance : public IMTServerPlugin,
 private:
    MTServerInfo      m_info;
    IMTServerAPI*     m_api;
-   MTUInt64Array     m_cleared;
+   CMTLoginSet       m_cleared;
 
 public:
                      CPluginInstance(void);
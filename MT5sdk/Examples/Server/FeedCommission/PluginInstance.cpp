@@ -112,6 +112,7 @@ MTAPIRES CPluginInstance::Stop(void)
 //--- clear all parameters
    m_symbols.Clear();
    m_group_mask.Clear();
+   m_group_matcher.Shutdown();
    m_currency.Clear();
 //--- 
    m_cost           =0;
@@ -209,6 +210,13 @@ MTAPIRES CPluginInstance::ParametersRead(void)
       return(MT_RET_ERR_PARAMS);
      }
    m_group_mask.Assign(param->ValueGroups());
+   if(!m_group_matcher.Compile(m_group_mask.Str()))
+     {
+      m_api->LoggerOutString(MTLogErr,L"groups mask compilation failed");
+      param->Release();
+      m_sync.Unlock();
+      return(MT_RET_ERR_MEM);
+     }
 //--- cost
    if((res=m_config->ParameterGet(L"Monthly cost",param))!=MT_RET_OK)
      {
@@ -326,7 +334,7 @@ void CPluginInstance::OnEOMFinish(const int64_t datetime,const int64_t prev_date
          return;
         }
       //--- check group name
-      if(CMTStr::CheckGroupMask(m_group_mask.Str(),group_name))
+      if(m_group_matcher.Check(group_name))
         {
          //--- check symbols
          for(uint32_t s=0;s<m_group->SymbolTotal();s++)
@@ -21,6 +21,7 @@ private:
    //--- plugin parameters
    CMTStr256         m_symbols;
    CMTStr256         m_group_mask;
+   CMTGroupMask      m_group_matcher;
    CMTStr128         m_currency;
    double            m_cost;
    double            m_deposit_max;
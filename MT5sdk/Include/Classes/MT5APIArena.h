@@ -0,0 +1,268 @@
+//+------------------------------------------------------------------+
+//|                                                 MetaTrader 5 API |
+//|                             Copyright 2000-2025, MetaQuotes Ltd. |
+//|                                               www.metaquotes.net |
+//+------------------------------------------------------------------+
+#pragma once
+#include <new.h>
+#include <string.h>
+//+------------------------------------------------------------------+
+//| Bump allocator                                                   |
+//| memory is taken from chunks sequentially and is freed all at     |
+//| once by Reset or by rewinding to a marker, freed chunks are kept |
+//| for reuse until Shutdown, the last allocation may be grown or    |
+//| freed in place, the class is not thread safe                     |
+//+------------------------------------------------------------------+
+class CMTArena
+  {
+public:
+   //--- position of the arena for rewinding
+   struct Marker
+     {
+      void             *chunk;               // current chunk
+      size_t            used;                // used bytes of chunk
+     };
+
+private:
+   enum constants
+     {
+      CHUNK_SIZE_DEFAULT=64*1024,            // default chunk size
+      ALIGN_DEFAULT     =16,                 // default alignment of allocations
+     };
+   //--- chunk header, data follows it
+   struct Chunk
+     {
+      Chunk            *prev;                // previous chunk of the arena or next free chunk
+      size_t            size;                // chunk size with header
+      size_t            used;                // used bytes when the next chunk was taken
+     };
+   //--- chunk header size, keeps data aligned
+   static const size_t CHUNK_HEADER=(sizeof(Chunk)+ALIGN_DEFAULT-1) & ~size_t(ALIGN_DEFAULT-1);
+
+private:
+   Chunk            *m_chunk;                // current chunk, chunks are linked from the newest
+   size_t            m_used;                 // used bytes of current chunk with header
+   char             *m_last;                 // last allocation for in place growth
+   Chunk            *m_free;                 // free chunks for reuse
+   size_t            m_chunk_size;           // default chunk size
+   size_t            m_reserved;             // bytes of all chunks
+
+public:
+   explicit          CMTArena(const size_t chunk_size=CHUNK_SIZE_DEFAULT);
+                    ~CMTArena(void)          { Shutdown(); }
+   //--- allocation
+   void*             Allocate(const size_t size,const size_t align=ALIGN_DEFAULT);
+   void*             Reallocate(void *ptr,const size_t size,const size_t new_size,const size_t align=ALIGN_DEFAULT);
+   void              Free(void *ptr,const size_t size);
+   template<class T>
+   T*                AllocateArray(const size_t count) { return((T*)Allocate(sizeof(T)*count,alignof(T)<ALIGN_DEFAULT ? size_t(ALIGN_DEFAULT) : alignof(T))); }
+   //--- free all allocations, chunks are kept for reuse
+   void              Reset(void);
+   Marker            Mark(void) const        { Marker marker={ m_chunk,m_used }; return(marker); }
+   void              Rewind(const Marker &marker);
+   //--- free all memory
+   void              Shutdown(void);
+   //--- statistics
+   size_t            Allocated(void) const;
+   size_t            Reserved(void) const    { return(m_reserved);  }
+
+private:
+   //--- prohibit copy constructor and assignment
+                     CMTArena(const CMTArena&);
+   CMTArena&         operator=(const CMTArena&);
+   //--- position in current chunk with aligned address
+   size_t            Aligned(const size_t align) const { return(size_t((((size_t)m_chunk+m_used+align-1) & ~(align-1))-(size_t)m_chunk)); }
+   //--- chunks
+   bool              ChunkNext(const size_t size,const size_t align);
+   void              ChunksRelease(Chunk *chunk,const Chunk *stop);
+  };
+//+------------------------------------------------------------------+
+//| Scoped rewinding of arena                                        |
+//| all allocations made during the scope lifetime are freed         |
+//+------------------------------------------------------------------+
+class CMTArenaScope
+  {
+private:
+   CMTArena         &m_arena;
+   CMTArena::Marker  m_marker;
+
+public:
+   explicit          CMTArenaScope(CMTArena &arena) : m_arena(arena),m_marker(arena.Mark()) {}
+                    ~CMTArenaScope(void)     { m_arena.Rewind(m_marker); }
+
+private:
+   //--- prohibit copy constructor and assignment
+                     CMTArenaScope(const CMTArenaScope&);
+   CMTArenaScope&    operator=(const CMTArenaScope&);
+  };
+//+------------------------------------------------------------------+
+//| Constructor                                                      |
+//+------------------------------------------------------------------+
+inline CMTArena::CMTArena(const size_t chunk_size/*=CHUNK_SIZE_DEFAULT*/) : m_chunk(NULL),m_used(0),m_last(NULL),m_free(NULL),
+                                                                          m_chunk_size(chunk_size>CHUNK_HEADER*2 ? chunk_size : size_t(CHUNK_SIZE_DEFAULT)),
+                                                                          m_reserved(0)
+  {
+  }
+//+------------------------------------------------------------------+
+//| Allocate memory, align must be power of 2, NULL on error         |
+//+------------------------------------------------------------------+
+inline void* CMTArena::Allocate(const size_t size,const size_t align/*=ALIGN_DEFAULT*/)
+  {
+//--- check
+   if(!size || (align & (align-1)))
+      return(NULL);
+//--- aligned position in current chunk
+   size_t pos=m_chunk ? Aligned(align) : 0;
+   if(!m_chunk || pos>m_chunk->size || m_chunk->size-pos<size)
+     {
+      if(!ChunkNext(size,align))
+         return(NULL);
+      pos=Aligned(align);
+     }
+//--- allocate
+   m_last=(char*)m_chunk+pos;
+   m_used=pos+size;
+   return(m_last);
+  }
+//+------------------------------------------------------------------+
+//| Grow or shrink allocation, the last one is changed in place      |
+//| contents are kept up to the smaller size, NULL on error          |
+//+------------------------------------------------------------------+
+inline void* CMTArena::Reallocate(void *ptr,const size_t size,const size_t new_size,const size_t align/*=ALIGN_DEFAULT*/)
+  {
+//--- new allocation
+   if(!ptr)
+      return(Allocate(new_size,align));
+//--- last allocation is resized in place if it fits
+   if(ptr==m_last)
+     {
+      const size_t pos=size_t((char*)ptr-(char*)m_chunk);
+      if(new_size && m_chunk->size-pos>=new_size)
+        {
+         m_used=pos+new_size;
+         return(ptr);
+        }
+     }
+//--- shrink is made in place
+   if(new_size && new_size<=size)
+      return(ptr);
+//--- copy to new allocation
+   void *res=Allocate(new_size,align);
+   if(res)
+      memcpy(res,ptr,size<new_size ? size : new_size);
+   return(res);
+  }
+//+------------------------------------------------------------------+
+//| Free allocation, only the last one is really freed               |
+//+------------------------------------------------------------------+
+inline void CMTArena::Free(void *ptr,const size_t size)
+  {
+   if(ptr && ptr==m_last)
+     {
+      m_used=size_t((char*)ptr-(char*)m_chunk);
+      m_last=NULL;
+     }
+  }
+//+------------------------------------------------------------------+
+//| Free all allocations, without work per allocation                |
+//+------------------------------------------------------------------+
+inline void CMTArena::Reset(void)
+  {
+   Marker marker={ NULL,0 };
+   Rewind(marker);
+  }
+//+------------------------------------------------------------------+
+//| Free allocations made after marker                               |
+//+------------------------------------------------------------------+
+inline void CMTArena::Rewind(const Marker &marker)
+  {
+//--- release chunks allocated after marker
+   ChunksRelease(m_chunk,(const Chunk*)marker.chunk);
+   m_chunk=(Chunk*)marker.chunk;
+//--- restore position
+   m_used=marker.used;
+   m_last=NULL;
+  }
+//+------------------------------------------------------------------+
+//| Allocated bytes with alignment gaps                              |
+//+------------------------------------------------------------------+
+inline size_t CMTArena::Allocated(void) const
+  {
+   size_t allocated=0;
+   for(const Chunk *chunk=m_chunk; chunk; chunk=chunk->prev)
+      allocated+=(chunk==m_chunk ? m_used : chunk->used)-CHUNK_HEADER;
+   return(allocated);
+  }
+//+------------------------------------------------------------------+
+//| Free all memory                                                  |
+//+------------------------------------------------------------------+
+inline void CMTArena::Shutdown(void)
+  {
+   Reset();
+//--- free chunks
+   while(m_free)
+     {
+      Chunk *next=m_free->prev;
+      delete[] (char*)m_free;
+      m_free=next;
+     }
+   m_reserved=0;
+  }
+//+------------------------------------------------------------------+
+//| Switch to free or new chunk fitting size                         |
+//+------------------------------------------------------------------+
+inline bool CMTArena::ChunkNext(const size_t size,const size_t align)
+  {
+//--- required chunk size
+   const size_t need=CHUNK_HEADER+size+(align>ALIGN_DEFAULT ? align : 0);
+   if(need<size)
+      return(false);
+//--- search the smallest fitting free chunk, so big chunks are left for big allocations
+   Chunk **best=NULL;
+   for(Chunk **link=&m_free; *link; link=&(*link)->prev)
+      if((*link)->size>=need && (!best || (*link)->size<(*best)->size))
+        {
+         best=link;
+         if((*link)->size==need)
+            break;
+        }
+   Chunk *chunk=NULL;
+   if(best)
+     {
+      chunk=*best;
+      *best=chunk->prev;
+     }
+//--- allocate new chunk
+   if(!chunk)
+     {
+      //--- big chunk gets space for in place growth of the last allocation
+      size_t chunk_size=m_chunk_size;
+      if(need>m_chunk_size)
+         chunk_size=need+need/2>need ? need+need/2 : need;
+      if((chunk=(Chunk*)new(std::nothrow) char[chunk_size])==NULL)
+         return(false);
+      chunk->size =chunk_size;
+      m_reserved +=chunk_size;
+     }
+//--- make chunk current
+   if(m_chunk)
+      m_chunk->used=m_used;
+   chunk->prev=m_chunk;
+   m_chunk    =chunk;
+   m_used     =CHUNK_HEADER;
+   return(true);
+  }
+//+------------------------------------------------------------------+
+//| Move chunks from chunk to stop to the free list                  |
+//+------------------------------------------------------------------+
+inline void CMTArena::ChunksRelease(Chunk *chunk,const Chunk *stop)
+  {
+   while(chunk && chunk!=stop)
+     {
+      Chunk *prev=chunk->prev;
+      chunk->prev=m_free;
+      m_free     =chunk;
+      chunk      =prev;
+     }
+  }
+//+------------------------------------------------------------------+
@@ -0,0 +1,659 @@
+//+------------------------------------------------------------------+
+//|                                                 MetaTrader 5 API |
+//|                             Copyright 2000-2025, MetaQuotes Ltd. |
+//|                                               www.metaquotes.net |
+//+------------------------------------------------------------------+
+#pragma once
+#include <new.h>
+#include <string.h>
+#include <type_traits>
+#include <utility>
+#include "MT5APISearch.h"
+//+------------------------------------------------------------------+
+//| Comparator adapter for SortFunctionPtr functions                 |
+//| allows to use existing sort functions of sorted arrays           |
+//+------------------------------------------------------------------+
+template <SMTSearch::SortFunctionPtr compare>
+struct TMTBTreeCompare
+  {
+   template <typename TKey,typename T>
+   int operator()(const TKey &key,const T &record) const
+     {
+      return(compare(&key,&record));
+     }
+  };
+//+------------------------------------------------------------------+
+//| Ordered B+tree of POD records                                    |
+//| replaces sorted TMTArray with Insert/Remove in O(log n)          |
+//| TCompare(key,record) returns <0, 0, >0 as SortFunctionPtr, it    |
+//| must accept records and may accept any other key types           |
+//| records are stored in leaves of TNodeSize bytes linked in list,  |
+//| pointers to records are invalidated by Insert and Remove         |
+//+------------------------------------------------------------------+
+template <class T,class TCompare,uint32_t TNodeSize=256>
+class TMTBTree final
+  {
+   //--- check record type
+                     static_assert(std::is_trivially_copyable<T>::value,"B-tree is for POD records only");
+   //--- node header
+   struct Node
+     {
+      uint32_t          count;              // records in leaf or keys in inner node
+      uint32_t          leaf;               // leaf flag
+     };
+   //--- node capacities
+   static constexpr uint32_t LEAF_CALC =uint32_t((TNodeSize-sizeof(Node)-2*sizeof(void*))/sizeof(T));
+   static constexpr uint32_t INNER_CALC=uint32_t((TNodeSize-sizeof(Node)-sizeof(void*))/(sizeof(T)+sizeof(void*)));
+   static constexpr uint32_t LEAF_MAX  =LEAF_CALC>4 ? LEAF_CALC : 4;       // maximum records in leaf
+   static constexpr uint32_t LEAF_MIN  =LEAF_MAX/2;                        // minimum records in leaf
+   static constexpr uint32_t INNER_MAX =INNER_CALC>4 ? INNER_CALC : 4;     // maximum keys in inner node
+   static constexpr uint32_t INNER_MIN =INNER_MAX/2;                       // minimum keys in inner node
+   //--- leaf, records in order
+   struct Leaf : Node
+     {
+      Leaf             *prev;               // previous leaf
+      Leaf             *next;               // next leaf
+      T                 items[LEAF_MAX];    // records
+     };
+   //--- inner node, keys[i] separates children[i] and children[i+1]
+   struct Inner : Node
+     {
+      Node             *children[INNER_MAX+1];
+      T                 keys[INNER_MAX];
+     };
+
+public:
+   //--- iterator over records in order
+   class Iterator
+     {
+      friend class TMTBTree;
+   private:
+      Leaf             *m_leaf;
+      uint32_t          m_pos;
+      //---
+                        Iterator(Leaf *leaf,uint32_t pos) : m_leaf(leaf),m_pos(pos) {}
+   public:
+      T&                operator*(void) const                    { return(m_leaf->items[m_pos]);  }
+      T*                operator->(void) const                   { return(&m_leaf->items[m_pos]); }
+      bool              operator!=(const Iterator &r) const      { return(m_leaf!=r.m_leaf || m_pos!=r.m_pos); }
+      bool              operator==(const Iterator &r) const      { return(m_leaf==r.m_leaf && m_pos==r.m_pos); }
+      Iterator&         operator++(void)
+        {
+         if(++m_pos>=m_leaf->count)
+           {
+            m_leaf=m_leaf->next;
+            m_pos =0;
+           }
+         return(*this);
+        }
+     };
+
+private:
+   const TCompare    m_compare;           // comparator
+   Node             *m_root=nullptr;      // root node
+   Leaf             *m_first=nullptr;     // first leaf
+   Leaf             *m_last=nullptr;      // last leaf
+   uint64_t          m_total=0;           // records total
+
+public:
+   //+------------------------------------------------------------------+
+   //| Constructor                                                      |
+   //+------------------------------------------------------------------+
+   TMTBTree(void)
+     {
+     }
+   //+------------------------------------------------------------------+
+   //| Destructor                                                       |
+   //+------------------------------------------------------------------+
+   ~TMTBTree(void)
+     {
+      Shutdown();
+     }
+   //+------------------------------------------------------------------+
+   //| Number of records                                                |
+   //+------------------------------------------------------------------+
+   uint64_t Total(void) const
+     {
+      return(m_total);
+     }
+   //+------------------------------------------------------------------+
+   //| Free all nodes                                                   |
+   //+------------------------------------------------------------------+
+   void Shutdown(void)
+     {
+      if(m_root)
+         NodeFree(m_root);
+      m_root =nullptr;
+      m_first=m_last=nullptr;
+      m_total=0;
+     }
+   //+------------------------------------------------------------------+
+   //| Insert new record                                                |
+   //| Returns nullptr if record already exists or allocation problem   |
+   //| Returns inserted record ptr otherwise                            |
+   //+------------------------------------------------------------------+
+   T* Insert(const T &elem)
+     {
+      //--- first leaf
+      if(!m_root)
+        {
+         Leaf *leaf=LeafCreate();
+         if(!leaf)
+            return(nullptr);
+         m_root=m_first=m_last=leaf;
+        }
+      //--- split full root, the tree grows from the top
+      if(NodeFull(m_root))
+        {
+         Inner *root=InnerCreate();
+         if(!root)
+            return(nullptr);
+         root->children[0]=m_root;
+         if(!SplitChild(root,0))
+           {
+            delete root;
+            return(nullptr);
+           }
+         m_root=root;
+        }
+      //--- go down, splitting full nodes on the way so the parent always has room
+      Node *node=m_root;
+      while(!node->leaf)
+        {
+         Inner   *inner=(Inner*)node;
+         uint32_t idx  =UpperIndex(inner->keys,inner->count,elem);
+         if(NodeFull(inner->children[idx]))
+           {
+            if(!SplitChild(inner,idx))
+               return(nullptr);
+            if(m_compare(elem,inner->keys[idx])>=0)
+               idx++;
+           }
+         node=inner->children[idx];
+        }
+      //--- insert to leaf
+      Leaf    *leaf=(Leaf*)node;
+      uint32_t pos =LowerIndex(leaf->items,leaf->count,elem);
+      if(pos<leaf->count && m_compare(elem,leaf->items[pos])==0)
+         return(nullptr);
+      memmove(&leaf->items[pos+1],&leaf->items[pos],sizeof(T)*(leaf->count-pos));
+      memcpy(&leaf->items[pos],&elem,sizeof(T));
+      leaf->count++;
+      m_total++;
+      //---
+      return(&leaf->items[pos]);
+     }
+   //+------------------------------------------------------------------+
+   //| Search and remove the first record equal to key                  |
+   //+------------------------------------------------------------------+
+   template <typename TKey>
+   bool Remove(const TKey &key)
+     {
+      Leaf    *leaf;
+      uint32_t pos;
+      //--- find the record
+      if(!LowerBound(key,leaf,pos) || m_compare(key,leaf->items[pos])!=0)
+         return(false);
+      //--- records are unique, so the full record defines the path
+      T record;
+      memcpy(&record,&leaf->items[pos],sizeof(T));
+      if(!RemoveNode(m_root,record))
+         return(false);
+      m_total--;
+      //--- shrink the tree from the top
+      if(!m_root->leaf && m_root->count==0)
+        {
+         Inner *root=(Inner*)m_root;
+         m_root=root->children[0];
+         delete root;
+        }
+      else
+         if(m_root->leaf && m_root->count==0)
+            Shutdown();
+      //---
+      return(true);
+     }
+   //+------------------------------------------------------------------+
+   //| Search by key value                                              |
+   //+------------------------------------------------------------------+
+   template <typename TKey>
+   T* Search(const TKey &key) const
+     {
+      return(SearchLeft(key));
+     }
+   //+------------------------------------------------------------------+
+   //| Search great or equal than key value                             |
+   //+------------------------------------------------------------------+
+   template <typename TKey>
+   T* SearchGreatOrEq(const TKey &key) const
+     {
+      Leaf    *leaf;
+      uint32_t pos;
+      return(LowerBound(key,leaf,pos) ? &leaf->items[pos] : nullptr);
+     }
+   //+------------------------------------------------------------------+
+   //| Search great than key value                                      |
+   //+------------------------------------------------------------------+
+   template <typename TKey>
+   T* SearchGreater(const TKey &key) const
+     {
+      Leaf    *leaf;
+      uint32_t pos;
+      return(UpperBound(key,leaf,pos) ? &leaf->items[pos] : nullptr);
+     }
+   //+------------------------------------------------------------------+
+   //| Search less or equal than key value                              |
+   //+------------------------------------------------------------------+
+   template <typename TKey>
+   T* SearchLessOrEq(const TKey &key) const
+     {
+      Leaf    *leaf;
+      uint32_t pos;
+      UpperBound(key,leaf,pos);
+      return(Prev(leaf,pos));
+     }
+   //+------------------------------------------------------------------+
+   //| Search less than key value                                       |
+   //+------------------------------------------------------------------+
+   template <typename TKey>
+   T* SearchLess(const TKey &key) const
+     {
+      Leaf    *leaf;
+      uint32_t pos;
+      LowerBound(key,leaf,pos);
+      return(Prev(leaf,pos));
+     }
+   //+------------------------------------------------------------------+
+   //| Search first record with key equal to key value                  |
+   //+------------------------------------------------------------------+
+   template <typename TKey>
+   T* SearchLeft(const TKey &key) const
+     {
+      T *record=SearchGreatOrEq(key);
+      return(record && m_compare(key,*record)==0 ? record : nullptr);
+     }
+   //+------------------------------------------------------------------+
+   //| Search last record with key equal to key value                   |
+   //+------------------------------------------------------------------+
+   template <typename TKey>
+   T* SearchRight(const TKey &key) const
+     {
+      T *record=SearchLessOrEq(key);
+      return(record && m_compare(key,*record)==0 ? record : nullptr);
+     }
+   //+------------------------------------------------------------------+
+   //| Iterate over records from 'from' to 'to' keys inclusive,         |
+   //| the functor returns false to stop                                |
+   //+------------------------------------------------------------------+
+   template <typename TKeyFrom,typename TKeyTo,typename TIterator>
+   void Range(const TKeyFrom &from,const TKeyTo &to,TIterator &&iterator) const
+     {
+      Leaf    *leaf;
+      uint32_t pos;
+      //--- the first record
+      if(!LowerBound(from,leaf,pos))
+         return;
+      //--- go through leaves
+      for(; leaf; leaf=leaf->next,pos=0)
+         for(; pos<leaf->count; pos++)
+            if(m_compare(to,leaf->items[pos])<0 || !iterator(leaf->items[pos]))
+               return;
+     }
+   //--- C++ iteration
+   Iterator          begin(void) const                           { return(Iterator(m_total ? m_first : nullptr,0)); }
+   Iterator          end(void) const                             { return(Iterator(nullptr,0));                     }
+
+private:
+   //--- prohibit copy constructor and assignment
+                     TMTBTree(const TMTBTree&)=delete;
+   const TMTBTree&   operator=(const TMTBTree&)=delete;
+   //+------------------------------------------------------------------+
+   //| First position with record not less than key                     |
+   //+------------------------------------------------------------------+
+   template <typename TKey>
+   uint32_t LowerIndex(const T *items,uint32_t count,const TKey &key) const
+     {
+      uint32_t lo=0;
+      while(count>0)
+        {
+         uint32_t half=count/2;
+         if(m_compare(key,items[lo+half])>0)
+           {
+            lo   +=half+1;
+            count-=half+1;
+           }
+         else
+            count=half;
+        }
+      return(lo);
+     }
+   //+------------------------------------------------------------------+
+   //| First position with record greater than key                      |
+   //+------------------------------------------------------------------+
+   template <typename TKey>
+   uint32_t UpperIndex(const T *items,uint32_t count,const TKey &key) const
+     {
+      uint32_t lo=0;
+      while(count>0)
+        {
+         uint32_t half=count/2;
+         if(m_compare(key,items[lo+half])>=0)
+           {
+            lo   +=half+1;
+            count-=half+1;
+           }
+         else
+            count=half;
+        }
+      return(lo);
+     }
+   //+------------------------------------------------------------------+
+   //| The first record not less than key                               |
+   //+------------------------------------------------------------------+
+   template <typename TKey>
+   bool LowerBound(const TKey &key,Leaf *&leaf,uint32_t &pos) const
+     {
+      Node *node=m_root;
+      //--- empty tree
+      leaf=nullptr;
+      pos =0;
+      if(!node || m_total==0)
+         return(false);
+      //--- children[i] contains records less than keys[i]
+      while(!node->leaf)
+        {
+         Inner *inner=(Inner*)node;
+         node=inner->children[LowerIndex(inner->keys,inner->count,key)];
+        }
+      //--- in the leaf or the first in the next one
+      leaf=(Leaf*)node;
+      pos =LowerIndex(leaf->items,leaf->count,key);
+      if(pos>=leaf->count)
+        {
+         leaf=leaf->next;
+         pos =0;
+        }
+      return(leaf!=nullptr);
+     }
+   //+------------------------------------------------------------------+
+   //| The first record greater than key                                |
+   //+------------------------------------------------------------------+
+   template <typename TKey>
+   bool UpperBound(const TKey &key,Leaf *&leaf,uint32_t &pos) const
+     {
+      Node *node=m_root;
+      //--- empty tree
+      leaf=nullptr;
+      pos =0;
+      if(!node || m_total==0)
+         return(false);
+      //--- children[i] contains records not less than keys[i-1]
+      while(!node->leaf)
+        {
+         Inner *inner=(Inner*)node;
+         node=inner->children[UpperIndex(inner->keys,inner->count,key)];
+        }
+      //--- in the leaf or the first in the next one
+      leaf=(Leaf*)node;
+      pos =UpperIndex(leaf->items,leaf->count,key);
+      if(pos>=leaf->count)
+        {
+         leaf=leaf->next;
+         pos =0;
+        }
+      return(leaf!=nullptr);
+     }
+   //+------------------------------------------------------------------+
+   //| Record before the position, nullptr leaf is the end of the tree  |
+   //+------------------------------------------------------------------+
+   T* Prev(Leaf *leaf,uint32_t pos) const
+     {
+      //--- before the end
+      if(!leaf)
+         return(m_last && m_total ? &m_last->items[m_last->count-1] : nullptr);
+      //--- in the same leaf
+      if(pos>0)
+         return(&leaf->items[pos-1]);
+      //--- in the previous leaf
+      return(leaf->prev ? &leaf->prev->items[leaf->prev->count-1] : nullptr);
+     }
+   //+------------------------------------------------------------------+
+   //| Nodes management                                                 |
+   //+------------------------------------------------------------------+
+   static Leaf* LeafCreate(void)
+     {
+      Leaf *leaf=new(std::nothrow) Leaf;
+      if(leaf)
+        {
+         leaf->count=0;
+         leaf->leaf =1;
+         leaf->prev =leaf->next=nullptr;
+        }
+      return(leaf);
+     }
+   static Inner* InnerCreate(void)
+     {
+      Inner *inner=new(std::nothrow) Inner;
+      if(inner)
+        {
+         inner->count=0;
+         inner->leaf =0;
+        }
+      return(inner);
+     }
+   static bool NodeFull(const Node *node)
+     {
+      return(node->count>=(node->leaf ? LEAF_MAX : INNER_MAX));
+     }
+   static void NodeFree(Node *node)
+     {
+      if(node->leaf)
+         delete (Leaf*)node;
+      else
+        {
+         Inner *inner=(Inner*)node;
+         for(uint32_t i=0; i<=inner->count; i++)
+            NodeFree(inner->children[i]);
+         delete inner;
+        }
+     }
+   //+------------------------------------------------------------------+
+   //| Split the full child in half, the parent is not full             |
+   //+------------------------------------------------------------------+
+   bool SplitChild(Inner *parent,uint32_t idx)
+     {
+      Node *child=parent->children[idx];
+      Node *right;
+      T     separator;
+      //--- leaf, the separator is the first record of the right half
+      if(child->leaf)
+        {
+         Leaf *left=(Leaf*)child,*leaf=LeafCreate();
+         if(!leaf)
+            return(false);
+         uint32_t mid=left->count/2;
+         memcpy(leaf->items,&left->items[mid],sizeof(T)*(left->count-mid));
+         leaf->count=left->count-mid;
+         left->count=mid;
+         //--- link
+         leaf->prev=left;
+         leaf->next=left->next;
+         if(left->next)
+            left->next->prev=leaf;
+         else
+            m_last=leaf;
+         left->next=leaf;
+         memcpy(&separator,&leaf->items[0],sizeof(T));
+         right=leaf;
+        }
+      //--- inner node, the middle key goes up
+      else
+        {
+         Inner *left=(Inner*)child,*inner=InnerCreate();
+         if(!inner)
+            return(false);
+         uint32_t mid=left->count/2;
+         memcpy(&separator,&left->keys[mid],sizeof(T));
+         memcpy(inner->keys,&left->keys[mid+1],sizeof(T)*(left->count-mid-1));
+         memcpy(inner->children,&left->children[mid+1],sizeof(Node*)*(left->count-mid));
+         inner->count=left->count-mid-1;
+         left->count =mid;
+         right=inner;
+        }
+      //--- insert separator to the parent
+      memmove(&parent->keys[idx+1],&parent->keys[idx],sizeof(T)*(parent->count-idx));
+      memmove(&parent->children[idx+2],&parent->children[idx+1],sizeof(Node*)*(parent->count-idx));
+      memcpy(&parent->keys[idx],&separator,sizeof(T));
+      parent->children[idx+1]=right;
+      parent->count++;
+      //---
+      return(true);
+     }
+   //+------------------------------------------------------------------+
+   //| Remove record from subtree and rebalance the children            |
+   //+------------------------------------------------------------------+
+   bool RemoveNode(Node *node,const T &record)
+     {
+      //--- leaf
+      if(node->leaf)
+        {
+         Leaf    *leaf=(Leaf*)node;
+         uint32_t pos =LowerIndex(leaf->items,leaf->count,record);
+         if(pos>=leaf->count || m_compare(record,leaf->items[pos])!=0)
+            return(false);
+         memmove(&leaf->items[pos],&leaf->items[pos+1],sizeof(T)*(leaf->count-pos-1));
+         leaf->count--;
+         return(true);
+        }
+      //--- inner node
+      Inner   *inner=(Inner*)node;
+      uint32_t idx  =UpperIndex(inner->keys,inner->count,record);
+      if(!RemoveNode(inner->children[idx],record))
+         return(false);
+      //--- check child underflow
+      Node *child=inner->children[idx];
+      if(child->count<(child->leaf ? LEAF_MIN : INNER_MIN))
+         Rebalance(inner,idx);
+      //---
+      return(true);
+     }
+   //+------------------------------------------------------------------+
+   //| Borrow from sibling or merge with it                             |
+   //+------------------------------------------------------------------+
+   void Rebalance(Inner *parent,uint32_t idx)
+     {
+      Node *child=parent->children[idx];
+      Node *left =idx>0 ? parent->children[idx-1] : nullptr;
+      Node *right=idx<parent->count ? parent->children[idx+1] : nullptr;
+      //--- leaves
+      if(child->leaf)
+        {
+         Leaf *leaf=(Leaf*)child,*lleaf=(Leaf*)left,*rleaf=(Leaf*)right;
+         //--- borrow the last record of the left sibling
+         if(lleaf && lleaf->count>LEAF_MIN)
+           {
+            memmove(&leaf->items[1],&leaf->items[0],sizeof(T)*leaf->count);
+            memcpy(&leaf->items[0],&lleaf->items[lleaf->count-1],sizeof(T));
+            leaf->count++;
+            lleaf->count--;
+            memcpy(&parent->keys[idx-1],&leaf->items[0],sizeof(T));
+            return;
+           }
+         //--- borrow the first record of the right sibling
+         if(rleaf && rleaf->count>LEAF_MIN)
+           {
+            memcpy(&leaf->items[leaf->count],&rleaf->items[0],sizeof(T));
+            memmove(&rleaf->items[0],&rleaf->items[1],sizeof(T)*(rleaf->count-1));
+            leaf->count++;
+            rleaf->count--;
+            memcpy(&parent->keys[idx],&rleaf->items[0],sizeof(T));
+            return;
+           }
+         //--- merge with a sibling, the right one is removed
+         if(lleaf)
+           {
+            LeafMerge(lleaf,leaf);
+            RemoveKey(parent,idx-1);
+           }
+         else
+           {
+            LeafMerge(leaf,rleaf);
+            RemoveKey(parent,idx);
+           }
+         return;
+        }
+      //--- inner nodes
+      Inner *inner=(Inner*)child,*linner=(Inner*)left,*rinner=(Inner*)right;
+      //--- rotate from the left sibling through the parent
+      if(linner && linner->count>INNER_MIN)
+        {
+         memmove(&inner->keys[1],&inner->keys[0],sizeof(T)*inner->count);
+         memmove(&inner->children[1],&inner->children[0],sizeof(Node*)*(inner->count+1));
+         memcpy(&inner->keys[0],&parent->keys[idx-1],sizeof(T));
+         inner->children[0]=linner->children[linner->count];
+         memcpy(&parent->keys[idx-1],&linner->keys[linner->count-1],sizeof(T));
+         inner->count++;
+         linner->count--;
+         return;
+        }
+      //--- rotate from the right sibling through the parent
+      if(rinner && rinner->count>INNER_MIN)
+        {
+         memcpy(&inner->keys[inner->count],&parent->keys[idx],sizeof(T));
+         inner->children[inner->count+1]=rinner->children[0];
+         memcpy(&parent->keys[idx],&rinner->keys[0],sizeof(T));
+         memmove(&rinner->keys[0],&rinner->keys[1],sizeof(T)*(rinner->count-1));
+         memmove(&rinner->children[0],&rinner->children[1],sizeof(Node*)*rinner->count);
+         inner->count++;
+         rinner->count--;
+         return;
+        }
+      //--- merge with a sibling, the separator goes down
+      if(linner)
+        {
+         InnerMerge(linner,inner,parent->keys[idx-1]);
+         RemoveKey(parent,idx-1);
+        }
+      else
+        {
+         InnerMerge(inner,rinner,parent->keys[idx]);
+         RemoveKey(parent,idx);
+        }
+     }
+   //+------------------------------------------------------------------+
+   //| Move all records of the right leaf to the left one               |
+   //+------------------------------------------------------------------+
+   void LeafMerge(Leaf *left,Leaf *right)
+     {
+      memcpy(&left->items[left->count],right->items,sizeof(T)*right->count);
+      left->count+=right->count;
+      //--- unlink
+      left->next=right->next;
+      if(right->next)
+         right->next->prev=left;
+      else
+         m_last=left;
+      delete right;
+     }
+   //+------------------------------------------------------------------+
+   //| Move separator and all keys of the right node to the left one    |
+   //+------------------------------------------------------------------+
+   static void InnerMerge(Inner *left,Inner *right,const T &separator)
+     {
+      memcpy(&left->keys[left->count],&separator,sizeof(T));
+      memcpy(&left->keys[left->count+1],right->keys,sizeof(T)*right->count);
+      memcpy(&left->children[left->count+1],right->children,sizeof(Node*)*(right->count+1));
+      left->count+=right->count+1;
+      delete right;
+     }
+   //+------------------------------------------------------------------+
+   //| Remove key idx and child idx+1 of the inner node                 |
+   //+------------------------------------------------------------------+
+   static void RemoveKey(Inner *inner,uint32_t idx)
+     {
+      memmove(&inner->keys[idx],&inner->keys[idx+1],sizeof(T)*(inner->count-idx-1));
+      memmove(&inner->children[idx+1],&inner->children[idx+2],sizeof(Node*)*(inner->count-idx-1));
+      inner->count--;
+     }
+  };
+//+------------------------------------------------------------------+
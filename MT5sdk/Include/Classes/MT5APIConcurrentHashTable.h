@@ -0,0 +1,210 @@
+//+------------------------------------------------------------------+
+//|                                                 MetaTrader 5 API |
+//|                             Copyright 2000-2025, MetaQuotes Ltd. |
+//|                                               www.metaquotes.net |
+//+------------------------------------------------------------------+
+#pragma once
+#include <utility>
+#include "MT5APIHashTable.h"
+//+------------------------------------------------------------------+
+//| Concurrent hash table                                            |
+//| keys are distributed over TShards independent hash tables,       |
+//| each shard is protected by its own reader/writer lock            |
+//| values are accessed only inside visitors under the shard lock    |
+//+------------------------------------------------------------------+
+template <typename TValue, typename THash, typename TEqual, uint32_t TShards=64, typename TAllocator=TMTHashAllocator<sizeof(TValue)+16>>
+class TMTConcurrentHashTable final
+  {
+   //--- check shards count
+                     static_assert(TShards>0 && (TShards & (TShards-1))==0, "Shards count must be a power of two");
+   //--- shard hash table type
+   using             ShardTable=TMTHashTable<TValue,THash,TEqual,TAllocator>;
+   //--- shard, aligned to avoid false sharing of locks
+   struct alignas(64) Shard
+     {
+      mutable SRWLOCK   lock;               // reader/writer lock
+      ShardTable        table;              // hash table with own allocator
+     };
+
+private:
+   const THash       m_hash;              // hash function
+   Shard             m_shards[TShards];   // shards
+
+public:
+   //+------------------------------------------------------------------+
+   //| Constructor                                                      |
+   //+------------------------------------------------------------------+
+   TMTConcurrentHashTable(void)
+     {
+      for(uint32_t i=0; i<TShards; i++)
+         InitializeSRWLock(&m_shards[i].lock);
+     }
+   //+------------------------------------------------------------------+
+   //| Destructor                                                       |
+   //+------------------------------------------------------------------+
+   ~TMTConcurrentHashTable(void)
+     {
+      Shutdown();
+     }
+   //+------------------------------------------------------------------+
+   //| Search for the element and pass it to the visitor                |
+   //| under the shared lock, returns false if nothing found            |
+   //+------------------------------------------------------------------+
+   template <typename TKey, typename TVisitor>
+   bool FindRead(const TKey &key, TVisitor &&visitor) const
+     {
+      const Shard &shard=ShardByKey(key);
+      bool         res  =false;
+      //--- shared lock
+      AcquireSRWLockShared(&shard.lock);
+      const TValue *value=shard.table.Find(key);
+      if(value)
+        {
+         visitor(*value);
+         res=true;
+        }
+      ReleaseSRWLockShared(&shard.lock);
+      //---
+      return(res);
+     }
+   //+------------------------------------------------------------------+
+   //| Check the element existence                                      |
+   //+------------------------------------------------------------------+
+   template <typename TKey>
+   bool Exists(const TKey &key) const
+     {
+      return(FindRead(key,[](const TValue&) {}));
+     }
+   //+------------------------------------------------------------------+
+   //| Find or insert the element and pass it to the functor            |
+   //| under the exclusive lock, returns false on allocation error      |
+   //+------------------------------------------------------------------+
+   template <typename TKey, typename TFunc>
+   bool Upsert(const TKey &key, TFunc &&func)
+     {
+      Shard &shard=ShardByKey(key);
+      bool   res  =false;
+      //--- exclusive lock
+      AcquireSRWLockExclusive(&shard.lock);
+      TValue *value=shard.table.FindOrInsert(key);
+      if(value)
+        {
+         func(*value);
+         res=true;
+        }
+      ReleaseSRWLockExclusive(&shard.lock);
+      //---
+      return(res);
+     }
+   //+------------------------------------------------------------------+
+   //| Delete the element                                               |
+   //+------------------------------------------------------------------+
+   template <typename TKey>
+   bool Remove(const TKey &key)
+     {
+      Shard &shard=ShardByKey(key);
+      //--- exclusive lock
+      AcquireSRWLockExclusive(&shard.lock);
+      const bool res=shard.table.Remove(key);
+      ReleaseSRWLockExclusive(&shard.lock);
+      //---
+      return(res);
+     }
+   //+------------------------------------------------------------------+
+   //| Iterate over each element, shards are locked one by one,         |
+   //| the functor returns false to stop                                |
+   //+------------------------------------------------------------------+
+   template <typename TIterator>
+   void IterateRead(TIterator &&iterator) const
+     {
+      bool next=true;
+      for(uint32_t i=0; i<TShards && next; i++)
+        {
+         Shard &shard=const_cast<Shard&>(m_shards[i]);
+         //--- shared lock
+         AcquireSRWLockShared(&shard.lock);
+         shard.table.Iterate([&iterator,&next](const TValue &value) { return(next=iterator(value)); });
+         ReleaseSRWLockShared(&shard.lock);
+        }
+     }
+   //+------------------------------------------------------------------+
+   //| Number of elements, not a snapshot under concurrent changes      |
+   //+------------------------------------------------------------------+
+   uint64_t Size(void) const
+     {
+      uint64_t total=0;
+      for(uint32_t i=0; i<TShards; i++)
+        {
+         AcquireSRWLockShared(&m_shards[i].lock);
+         total+=m_shards[i].table.Size();
+         ReleaseSRWLockShared(&m_shards[i].lock);
+        }
+      return(total);
+     }
+   //+------------------------------------------------------------------+
+   //| Preparing shards of a predetermined total size                   |
+   //+------------------------------------------------------------------+
+   bool Reserve(const uint64_t count)
+     {
+      bool res=true;
+      for(uint32_t i=0; i<TShards; i++)
+        {
+         AcquireSRWLockExclusive(&m_shards[i].lock);
+         if(m_shards[i].table.Size()==0)
+            res=m_shards[i].table.Reserve(count/TShards+1) && res;
+         ReleaseSRWLockExclusive(&m_shards[i].lock);
+        }
+      return(res);
+     }
+   //+------------------------------------------------------------------+
+   //| Incremental rebuild mode of the shards                           |
+   //+------------------------------------------------------------------+
+   void IncrementalRebuild(const uint64_t buckets_per_operation)
+     {
+      for(uint32_t i=0; i<TShards; i++)
+        {
+         AcquireSRWLockExclusive(&m_shards[i].lock);
+         m_shards[i].table.IncrementalRebuild(buckets_per_operation);
+         ReleaseSRWLockExclusive(&m_shards[i].lock);
+        }
+     }
+   //+------------------------------------------------------------------+
+   //| Clear all shards and free all allocated memory                   |
+   //+------------------------------------------------------------------+
+   void Shutdown(void)
+     {
+      for(uint32_t i=0; i<TShards; i++)
+        {
+         AcquireSRWLockExclusive(&m_shards[i].lock);
+         m_shards[i].table.Shutdown();
+         ReleaseSRWLockExclusive(&m_shards[i].lock);
+        }
+     }
+
+private:
+   //--- prohibit copy constructor and assignment
+                     TMTConcurrentHashTable(const TMTConcurrentHashTable&)=delete;
+   const TMTConcurrentHashTable& operator=(const TMTConcurrentHashTable&)=delete;
+   //+------------------------------------------------------------------+
+   //| Shard by key, the high bits of the mixed hash are used           |
+   //| since the shard table uses the low ones                          |
+   //+------------------------------------------------------------------+
+   template <typename TKey>
+   Shard& ShardByKey(const TKey &key)
+     {
+      return(m_shards[ShardIndex(m_hash(key))]);
+     }
+   template <typename TKey>
+   const Shard& ShardByKey(const TKey &key) const
+     {
+      return(m_shards[ShardIndex(m_hash(key))]);
+     }
+   static uint32_t ShardIndex(uint64_t hash)
+     {
+      hash^=hash >> 33;
+      hash*=0xff51afd7ed558ccdULL;
+      hash^=hash >> 33;
+      return(uint32_t(hash >> 32) & (TShards-1));
+     }
+  };
+//+------------------------------------------------------------------+
@@ -0,0 +1,246 @@
+//+------------------------------------------------------------------+
+//|                                                 MetaTrader 5 API |
+//|                             Copyright 2000-2025, MetaQuotes Ltd. |
+//|                                               www.metaquotes.net |
+//+------------------------------------------------------------------+
+#pragma once
+//+------------------------------------------------------------------+
+//| Memory mapped file                                               |
+//| read only or read/write view of the whole file,                  |
+//| Grow and Truncate remap the view, previous pointers become       |
+//| invalid, the class is not thread safe                            |
+//+------------------------------------------------------------------+
+class CMTFileMap
+  {
+public:
+   //--- open modes
+   enum EnMapMode
+     {
+      MAP_READ         =0,                   // read only view of existing file
+      MAP_WRITE        =1,                   // read/write view, file is created if absent
+     };
+   //--- access hints
+   enum EnAccessHint
+     {
+      ACCESS_NORMAL    =0,                   // no hint
+      ACCESS_SEQUENTIAL=1,                   // sequential scan, aggressive read ahead
+      ACCESS_RANDOM    =2,                   // random access, no read ahead
+     };
+
+private:
+   HANDLE            m_file;                 // file handle
+   HANDLE            m_mapping;              // file mapping
+   char             *m_view;                 // mapped view
+   uint64_t          m_size;                 // view and file size
+   uint32_t          m_mode;                 // open mode
+
+public:
+                     CMTFileMap(void) : m_file(INVALID_HANDLE_VALUE),m_mapping(NULL),m_view(NULL),m_size(0),m_mode(MAP_READ) {}
+                    ~CMTFileMap(void)        { Close(); }
+   //--- open/close
+   bool              Open(LPCWSTR path,const uint32_t mode,const uint32_t hint=ACCESS_NORMAL,const uint64_t size=0);
+   void              Close(void);
+   //--- properties
+   bool              IsOpen(void) const      { return(m_file!=INVALID_HANDLE_VALUE);      }
+   uint64_t          Size(void) const        { return(m_size);                            }
+   const void*       Data(void) const        { return(m_view);                            }
+   void*             Buffer(void)            { return(m_mode==MAP_WRITE ? m_view : NULL); }
+   //--- size change with remapping
+   bool              Grow(const uint64_t size);
+   bool              Truncate(const uint64_t size);
+   //--- hints and flushing
+   bool              Prefetch(const uint64_t offset,const uint64_t length) const;
+   bool              Flush(const uint64_t offset=0,const uint64_t length=0);
+   bool              Sync(void);
+
+private:
+   //--- prohibit copy constructor and assignment
+                     CMTFileMap(const CMTFileMap&);
+   CMTFileMap&       operator=(const CMTFileMap&);
+   //--- view operations
+   bool              Map(void);
+   void              Unmap(void);
+  };
+//+------------------------------------------------------------------+
+//| Open and map file                                                |
+//| size is the minimal size of the file in write mode               |
+//+------------------------------------------------------------------+
+inline bool CMTFileMap::Open(LPCWSTR path,const uint32_t mode,const uint32_t hint/*=ACCESS_NORMAL*/,const uint64_t size/*=0*/)
+  {
+   DWORD flags=FILE_ATTRIBUTE_NORMAL;
+   LARGE_INTEGER li={};
+//--- close previous
+   Close();
+//--- check
+   if(!path || mode>MAP_WRITE)
+      return(false);
+//--- access hint is applied by the cache manager to the mapped pages too
+   if(hint==ACCESS_SEQUENTIAL) flags|=FILE_FLAG_SEQUENTIAL_SCAN;
+   if(hint==ACCESS_RANDOM)     flags|=FILE_FLAG_RANDOM_ACCESS;
+//--- open file
+   if(mode==MAP_WRITE)
+      m_file=CreateFileW(path,GENERIC_READ|GENERIC_WRITE,FILE_SHARE_READ,NULL,OPEN_ALWAYS,flags,NULL);
+   else
+      m_file=CreateFileW(path,GENERIC_READ,FILE_SHARE_READ|FILE_SHARE_WRITE,NULL,OPEN_EXISTING,flags,NULL);
+   if(m_file==INVALID_HANDLE_VALUE)
+      return(false);
+   m_mode=mode;
+//--- file size
+   if(!GetFileSizeEx(m_file,&li))
+     {
+      Close();
+      return(false);
+     }
+   m_size=uint64_t(li.QuadPart);
+   if(mode==MAP_WRITE && size>m_size)
+      m_size=size;
+//--- map
+   if(!Map())
+     {
+      Close();
+      return(false);
+     }
+//--- ok
+   return(true);
+  }
+//+------------------------------------------------------------------+
+//| Unmap and close file                                             |
+//+------------------------------------------------------------------+
+inline void CMTFileMap::Close(void)
+  {
+   Unmap();
+   if(m_file!=INVALID_HANDLE_VALUE)
+     {
+      CloseHandle(m_file);
+      m_file=INVALID_HANDLE_VALUE;
+     }
+   m_size=0;
+   m_mode=MAP_READ;
+  }
+//+------------------------------------------------------------------+
+//| Grow file and remap view, size is never decreased                |
+//+------------------------------------------------------------------+
+inline bool CMTFileMap::Grow(const uint64_t size)
+  {
+//--- check
+   if(!IsOpen() || m_mode!=MAP_WRITE)
+      return(false);
+   if(size<=m_size)
+      return(true);
+//--- mapping of the bigger size extends the file
+   Unmap();
+   const uint64_t prev=m_size;
+   m_size=size;
+   if(Map())
+      return(true);
+//--- restore previous view
+   m_size=prev;
+   Map();
+   return(false);
+  }
+//+------------------------------------------------------------------+
+//| Cut file to the size and remap view                              |
+//+------------------------------------------------------------------+
+inline bool CMTFileMap::Truncate(const uint64_t size)
+  {
+   LARGE_INTEGER li={};
+//--- check
+   if(!IsOpen() || m_mode!=MAP_WRITE || size>m_size)
+      return(false);
+//--- file can not be cut while it is mapped
+   Unmap();
+   li.QuadPart=LONGLONG(size);
+   const bool res=SetFilePointerEx(m_file,li,NULL,FILE_BEGIN) && SetEndOfFile(m_file);
+   if(res)
+      m_size=size;
+//--- map again
+   return(Map() && res);
+  }
+//+------------------------------------------------------------------+
+//| Ask the system to read the range in advance                      |
+//| PrefetchVirtualMemory is available since Windows 8               |
+//+------------------------------------------------------------------+
+inline bool CMTFileMap::Prefetch(const uint64_t offset,const uint64_t length) const
+  {
+   typedef struct { PVOID address; SIZE_T size; } PrefetchRange;
+   typedef BOOL (WINAPI *PrefetchVirtualMemoryPtr)(HANDLE,ULONG_PTR,PrefetchRange*,ULONG);
+   static PrefetchVirtualMemoryPtr s_prefetch=NULL;
+   static volatile LONG            s_resolved=0;
+//--- check
+   if(!m_view || offset>=m_size)
+      return(false);
+//--- resolve function once
+   if(!s_resolved)
+     {
+      if(HMODULE kernel=GetModuleHandleW(L"kernel32.dll"))
+         s_prefetch=(PrefetchVirtualMemoryPtr)GetProcAddress(kernel,"PrefetchVirtualMemory");
+      InterlockedExchange(&s_resolved,1);
+     }
+   if(!s_prefetch)
+      return(false);
+//--- prefetch
+   PrefetchRange range={ m_view+offset,SIZE_T(length && length<m_size-offset ? length : m_size-offset) };
+   return(s_prefetch(GetCurrentProcess(),1,&range,0)!=FALSE);
+  }
+//+------------------------------------------------------------------+
+//| Write dirty pages of the range to file, length 0 - up to the end |
+//+------------------------------------------------------------------+
+inline bool CMTFileMap::Flush(const uint64_t offset/*=0*/,const uint64_t length/*=0*/)
+  {
+//--- check
+   if(!m_view || m_mode!=MAP_WRITE || offset>=m_size)
+      return(m_mode==MAP_WRITE && IsOpen());
+//--- flush
+   return(FlushViewOfFile(m_view+offset,SIZE_T(length && length<m_size-offset ? length : m_size-offset))!=FALSE);
+  }
+//+------------------------------------------------------------------+
+//| Write dirty pages and file metadata to disk                      |
+//+------------------------------------------------------------------+
+inline bool CMTFileMap::Sync(void)
+  {
+   return(Flush() && FlushFileBuffers(m_file)!=FALSE);
+  }
+//+------------------------------------------------------------------+
+//| Map whole file of m_size, empty file has no view                 |
+//+------------------------------------------------------------------+
+inline bool CMTFileMap::Map(void)
+  {
+   LARGE_INTEGER li={};
+//--- empty file can not be mapped
+   if(!m_size)
+      return(true);
+//--- view must fit to address space
+   if(m_size>uint64_t(SIZE_T(-1)))
+      return(false);
+//--- create mapping, read/write mapping extends the file to m_size
+   li.QuadPart=LONGLONG(m_size);
+   m_mapping=CreateFileMappingW(m_file,NULL,m_mode==MAP_WRITE ? PAGE_READWRITE : PAGE_READONLY,DWORD(li.HighPart),li.LowPart,NULL);
+   if(!m_mapping)
+      return(false);
+//--- map view
+   if((m_view=(char*)MapViewOfFile(m_mapping,m_mode==MAP_WRITE ? FILE_MAP_WRITE : FILE_MAP_READ,0,0,SIZE_T(m_size)))==NULL)
+     {
+      CloseHandle(m_mapping);
+      m_mapping=NULL;
+      return(false);
+     }
+//--- ok
+   return(true);
+  }
+//+------------------------------------------------------------------+
+//| Unmap view                                                       |
+//+------------------------------------------------------------------+
+inline void CMTFileMap::Unmap(void)
+  {
+   if(m_view)
+     {
+      UnmapViewOfFile(m_view);
+      m_view=NULL;
+     }
+   if(m_mapping)
+     {
+      CloseHandle(m_mapping);
+      m_mapping=NULL;
+     }
+  }
+//+------------------------------------------------------------------+
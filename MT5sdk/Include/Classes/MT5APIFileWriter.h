@@ -0,0 +1,282 @@
+//+------------------------------------------------------------------+
+//|                                                 MetaTrader 5 API |
+//|                             Copyright 2000-2025, MetaQuotes Ltd. |
+//|                                               www.metaquotes.net |
+//+------------------------------------------------------------------+
+#pragma once
+#include <new.h>
+#include <string.h>
+#include "MT5APIFile.h"
+#include "MT5APIThread.h"
+//+------------------------------------------------------------------+
+//| Sequential file writer with write-behind                         |
+//| small writes are collected in the active buffer, full buffer     |
+//| is written to file by the background thread while the next one   |
+//| is filled, Flush passes all data to file, Sync also to disk      |
+//| calls must be serialized by the caller                           |
+//+------------------------------------------------------------------+
+class CMTFileWriter
+  {
+private:
+   enum constants
+     {
+      BUFFER_SIZE_DEFAULT=1024*1024,         // default buffer size
+      BUFFER_SIZE_MIN    =4*1024,            // minimal buffer size
+     };
+   //--- data buffer
+   struct Buffer
+     {
+      char             *data;                // buffer data
+      uint32_t          used;                // used bytes
+     };
+
+private:
+   CMTFile           m_file;                 // file
+   uint64_t          m_position;             // file position with buffered data
+   Buffer            m_buffers[2];           // active and writing buffers
+   uint32_t          m_buffer_size;          // buffer size
+   uint32_t          m_active;               // index of buffer being filled
+   //--- background writing
+   CMTThread         m_thread;               // writing thread
+   SRWLOCK           m_lock;                 // lock of state below
+   CONDITION_VARIABLE m_cond;                // state change
+   Buffer           *m_pending;              // buffer to write, NULL - thread is idle
+   bool              m_stop;                 // thread stop flag
+   bool              m_error;                // write error, writer is unusable until reopen
+
+public:
+                     CMTFileWriter(void);
+                    ~CMTFileWriter(void)     { Close(); }
+   //--- open/close
+   bool              Open(LPCWSTR path,const bool append,const uint32_t buffer_size=0);
+   bool              Close(void);
+   //--- properties
+   bool              IsOpen(void) const      { return(m_file.IsOpen()); }
+   uint64_t          Position(void) const    { return(m_position);      }
+   //--- writing
+   bool              Write(const void *data,const uint32_t length);
+   bool              Flush(void);
+   bool              Sync(void);
+
+private:
+   //--- prohibit copy constructor and assignment
+                     CMTFileWriter(const CMTFileWriter&);
+   CMTFileWriter&    operator=(const CMTFileWriter&);
+   //--- buffers passing
+   bool              Submit(void);
+   bool              WaitIdle(void);
+   //--- writing thread
+   static unsigned __stdcall ProcessWrapper(void *param);
+   void              Process(void);
+  };
+//+------------------------------------------------------------------+
+//| Constructor                                                      |
+//+------------------------------------------------------------------+
+inline CMTFileWriter::CMTFileWriter(void) : m_position(0),m_buffer_size(0),m_active(0),m_pending(NULL),m_stop(false),m_error(false)
+  {
+   ZeroMemory(m_buffers,sizeof(m_buffers));
+   InitializeSRWLock(&m_lock);
+   InitializeConditionVariable(&m_cond);
+  }
+//+------------------------------------------------------------------+
+//| Open file for writing from the beginning or from the end         |
+//+------------------------------------------------------------------+
+inline bool CMTFileWriter::Open(LPCWSTR path,const bool append,const uint32_t buffer_size/*=0*/)
+  {
+//--- close previous
+   Close();
+//--- open file
+   if(!m_file.Open(path,GENERIC_WRITE,FILE_SHARE_READ,append ? OPEN_ALWAYS : CREATE_ALWAYS,FILE_ATTRIBUTE_NORMAL|FILE_FLAG_SEQUENTIAL_SCAN))
+      return(false);
+   if((m_position=m_file.Seek(0,FILE_END))==CMTFile::INVALID_POSITION)
+     {
+      m_file.Close();
+      m_position=0;
+      return(false);
+     }
+//--- allocate buffers
+   m_buffer_size=buffer_size ? (buffer_size<BUFFER_SIZE_MIN ? BUFFER_SIZE_MIN : buffer_size) : BUFFER_SIZE_DEFAULT;
+   for(uint32_t i=0; i<_countof(m_buffers); i++)
+      if((m_buffers[i].data=new(std::nothrow) char[m_buffer_size])==NULL)
+        {
+         Close();
+         return(false);
+        }
+//--- start writing thread
+   m_stop =false;
+   m_error=false;
+   if(!m_thread.Start(ProcessWrapper,this,0))
+     {
+      Close();
+      return(false);
+     }
+//--- ok
+   return(true);
+  }
+//+------------------------------------------------------------------+
+//| Flush data, stop thread and close file                           |
+//| false if some data has not been written                          |
+//+------------------------------------------------------------------+
+inline bool CMTFileWriter::Close(void)
+  {
+   bool res=true;
+//--- flush buffered data
+   if(m_buffer_size && m_thread.Handle())
+     {
+      res=Flush();
+      //--- stop thread
+      AcquireSRWLockExclusive(&m_lock);
+      m_stop=true;
+      WakeAllConditionVariable(&m_cond);
+      ReleaseSRWLockExclusive(&m_lock);
+      m_thread.Shutdown();
+     }
+//--- free buffers
+   for(uint32_t i=0; i<_countof(m_buffers); i++)
+     {
+      if(m_buffers[i].data)
+         delete[] m_buffers[i].data;
+      m_buffers[i].data=NULL;
+      m_buffers[i].used=0;
+     }
+//--- close file
+   m_file.Close();
+   m_position   =0;
+   m_buffer_size=0;
+   m_active     =0;
+   m_pending    =NULL;
+   return(res);
+  }
+//+------------------------------------------------------------------+
+//| Write data, small writes are coalesced in the active buffer      |
+//+------------------------------------------------------------------+
+inline bool CMTFileWriter::Write(const void *data,const uint32_t length)
+  {
+   const char *ptr=(const char*)data;
+   uint32_t    left=length;
+//--- check
+   if(!m_buffer_size || m_error || (!data && length))
+      return(false);
+//--- copy data to buffers
+   while(left)
+     {
+      Buffer &buffer=m_buffers[m_active];
+      //--- big block with empty active buffer is written directly after the pending one
+      if(!buffer.used && left>=m_buffer_size)
+        {
+         if(!WaitIdle())
+            return(false);
+         if(m_file.Write(ptr,left)!=left)
+           {
+            m_error=true;
+            return(false);
+           }
+         m_position+=left;
+         return(true);
+        }
+      //--- append to active buffer
+      const uint32_t copy=(left<m_buffer_size-buffer.used) ? left : m_buffer_size-buffer.used;
+      memcpy(buffer.data+buffer.used,ptr,copy);
+      buffer.used+=copy;
+      m_position +=copy;
+      ptr        +=copy;
+      left       -=copy;
+      //--- full buffer is passed to the writing thread
+      if(buffer.used==m_buffer_size && !Submit())
+         return(false);
+     }
+//--- ok
+   return(true);
+  }
+//+------------------------------------------------------------------+
+//| Pass all buffered data to file and wait for writing              |
+//+------------------------------------------------------------------+
+inline bool CMTFileWriter::Flush(void)
+  {
+//--- check
+   if(!m_buffer_size)
+      return(false);
+//--- pass active buffer and wait
+   if(m_buffers[m_active].used && !Submit())
+      return(false);
+   return(WaitIdle());
+  }
+//+------------------------------------------------------------------+
+//| Flush data and file system buffers to disk                       |
+//+------------------------------------------------------------------+
+inline bool CMTFileWriter::Sync(void)
+  {
+   return(Flush() && m_file.Flush());
+  }
+//+------------------------------------------------------------------+
+//| Pass active buffer to writing thread and switch to the other one |
+//+------------------------------------------------------------------+
+inline bool CMTFileWriter::Submit(void)
+  {
+//--- wait for the other buffer writing
+   AcquireSRWLockExclusive(&m_lock);
+   while(m_pending && !m_error)
+      SleepConditionVariableSRW(&m_cond,&m_lock,INFINITE,0);
+   if(m_error)
+     {
+      ReleaseSRWLockExclusive(&m_lock);
+      return(false);
+     }
+//--- pass buffer
+   m_pending=&m_buffers[m_active];
+   WakeAllConditionVariable(&m_cond);
+   ReleaseSRWLockExclusive(&m_lock);
+//--- switch to the free buffer
+   m_active^=1;
+   m_buffers[m_active].used=0;
+   return(true);
+  }
+//+------------------------------------------------------------------+
+//| Wait for pending buffer writing, false on write error            |
+//+------------------------------------------------------------------+
+inline bool CMTFileWriter::WaitIdle(void)
+  {
+   AcquireSRWLockExclusive(&m_lock);
+   while(m_pending && !m_error)
+      SleepConditionVariableSRW(&m_cond,&m_lock,INFINITE,0);
+   const bool res=!m_error;
+   ReleaseSRWLockExclusive(&m_lock);
+   return(res);
+  }
+//+------------------------------------------------------------------+
+//| Writing thread entry                                             |
+//+------------------------------------------------------------------+
+inline unsigned __stdcall CMTFileWriter::ProcessWrapper(void *param)
+  {
+   CMTFileWriter *writer=reinterpret_cast<CMTFileWriter*>(param);
+   if(writer)
+      writer->Process();
+   return(0);
+  }
+//+------------------------------------------------------------------+
+//| Write pending buffers until stop                                 |
+//+------------------------------------------------------------------+
+inline void CMTFileWriter::Process(void)
+  {
+   AcquireSRWLockExclusive(&m_lock);
+   for(;;)
+     {
+      //--- wait for buffer
+      while(!m_pending && !m_stop)
+         SleepConditionVariableSRW(&m_cond,&m_lock,INFINITE,0);
+      if(!m_pending)
+         break;
+      Buffer *buffer=m_pending;
+      //--- write without lock, the owner fills the other buffer meanwhile
+      ReleaseSRWLockExclusive(&m_lock);
+      const bool res=(m_file.Write(buffer->data,buffer->used)==buffer->used);
+      AcquireSRWLockExclusive(&m_lock);
+      //--- buffer is free
+      if(!res)
+         m_error=true;
+      m_pending=NULL;
+      WakeAllConditionVariable(&m_cond);
+     }
+   ReleaseSRWLockExclusive(&m_lock);
+  }
+//+------------------------------------------------------------------+
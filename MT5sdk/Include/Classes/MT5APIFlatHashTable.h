@@ -0,0 +1,533 @@
+//+------------------------------------------------------------------+
+//|                                                 MetaTrader 5 API |
+//|                             Copyright 2000-2025, MetaQuotes Ltd. |
+//|                                               www.metaquotes.net |
+//+------------------------------------------------------------------+
+#pragma once
+#include <utility>
+#include "MT5APIHashTable.h"
+//--- SIMD group probing
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define MTAPI_FLAT_HASH_SSE2
+#include <emmintrin.h>
+#if defined(__AVX2__)
+#define MTAPI_FLAT_HASH_AVX2
+#include <immintrin.h>
+#endif
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+//+------------------------------------------------------------------+
+//| Hash table with open addressing                                  |
+//| values are stored inline in a flat slot array, each slot has     |
+//| a control byte, control bytes are probed in groups of 16         |
+//| no duplicates, checks for duplicates                             |
+//| IMPORTANT: references are invalidated by table growth            |
+//+------------------------------------------------------------------+
+template <typename TValue, typename THash, typename TEqual, typename TAllocator=TMTHashAllocator<sizeof(void*)>>
+class TMTFlatHashTable final
+  {
+   //--- constants
+   static constexpr uint64_t GROUP_WIDTH  =16;             // control bytes in a group
+   static constexpr uint64_t COUNT_INITIAL=512;            // default initial table size
+   static constexpr uint64_t COUNT_MIN    =GROUP_WIDTH*2;  // minimal table size
+   static constexpr uint64_t SLOTS_ALIGN  =64;             // slots array alignment
+   static constexpr uint64_t INVALID_INDEX=~0ULL;          // invalid slot index
+   //--- control byte values, full slots store the low 7 bits of the hash
+   static constexpr int8_t   CTRL_EMPTY   =-128;           // 0x80, slot is empty
+   static constexpr int8_t   CTRL_DELETED =-2;             // 0xFE, slot is deleted (tombstone)
+   //--- check sizes
+                     static_assert(alignof(TValue)<=SLOTS_ALIGN, "Too big value alignment");
+
+public:
+   //--- iterator template class
+   template<typename T>
+   class TIterator final
+     {
+      friend            TMTFlatHashTable;            // table class is friend
+
+   private:
+      const int8_t     *m_ctrl{};                    // control bytes pointer
+      T                *m_slots{};                   // slots pointer
+      uint64_t          m_count{};                   // table size
+      uint64_t          m_index{};                   // current slot index
+      T                *m_item{};                    // current item pointer
+
+   public:
+                        TIterator(void)=default;
+      //--- constructor to iterate from the beginning of the table, moves to the first existing element
+                        TIterator(const int8_t *ctrl,T *slots,const uint64_t count) : m_ctrl{ctrl},m_slots{slots},m_count{count}
+        {
+         if(m_ctrl)
+            Seek(0);
+        }
+      //--- value
+      T&                operator *(void) &                     { return *m_item; }
+      T&&               operator *(void) &&                    { return std::move(*m_item); }
+      //--- pointer to value
+      T*                operator->(void)                       { return(m_item); }
+      //--- comparation
+      bool              operator==(const TIterator &r) const   { return m_item==r.m_item; }
+      bool              operator!=(const TIterator &r) const   { return m_item!=r.m_item; }
+      operator          bool(void) const                       { return m_item!=nullptr; }
+      //--- iteration
+      TIterator&        operator++(void)
+        {
+         if(m_item)
+            Seek(m_index+1);
+         return *this;
+        }
+
+   private:
+      //--- move to the first full slot starting from index
+      void              Seek(const uint64_t index)
+        {
+         m_index=TMTFlatHashTable::NextFull(m_ctrl,m_count,index);
+         m_item =m_index<m_count ? m_slots+m_index : nullptr;
+        }
+     };
+   //--- iterators classes
+   using             Iterator=TIterator<TValue>;
+   using             ConstIterator=TIterator<const TValue>;
+
+private:
+   TAllocator        m_allocator;         // allocator
+   const THash       m_hash;              // hash function
+   const TEqual      m_equal;             // equivalence function
+
+   void             *m_memory =nullptr;   // allocated block: control bytes followed by slots
+   int8_t           *m_ctrl   =nullptr;   // control bytes
+   TValue           *m_slots  =nullptr;   // slots
+   uint64_t          m_count  =0;         // current hash table size (slots)
+   uint64_t          m_filled =0;         // number of elements
+   uint64_t          m_deleted=0;         // number of deleted slots (tombstones)
+   uint64_t          m_mask   =0;         // groups mask calculated in advance
+
+public:
+   //+------------------------------------------------------------------+
+   //| Constructor                                                      |
+   //+------------------------------------------------------------------+
+   explicit TMTFlatHashTable(void)
+     {
+     }
+   //+------------------------------------------------------------------+
+   //| Constructor                                                      |
+   //+------------------------------------------------------------------+
+   explicit TMTFlatHashTable(const TAllocator &allocator) : m_allocator(allocator)
+     {
+     }
+   //+------------------------------------------------------------------+
+   //| Move constructor                                                 |
+   //+------------------------------------------------------------------+
+   TMTFlatHashTable(TMTFlatHashTable &&r) : m_allocator(std::move(r.m_allocator)),m_hash(std::move(r.m_hash)),m_equal(std::move(r.m_equal)),
+                                            m_memory(r.m_memory),m_ctrl(r.m_ctrl),m_slots(r.m_slots),m_count(r.m_count),m_filled(r.m_filled),m_deleted(r.m_deleted),m_mask(r.m_mask)
+     {
+      r.m_memory =nullptr;
+      r.m_ctrl   =nullptr;
+      r.m_slots  =nullptr;
+      r.m_count  =0;
+      r.m_filled =0;
+      r.m_deleted=0;
+      r.m_mask   =0;
+     }
+   //+------------------------------------------------------------------+
+   //| Destructor                                                       |
+   //+------------------------------------------------------------------+
+   ~TMTFlatHashTable(void)
+     {
+      Shutdown();
+     }
+   //+------------------------------------------------------------------+
+   //| Move operator                                                    |
+   //+------------------------------------------------------------------+
+   TMTFlatHashTable& operator=(TMTFlatHashTable &&r)
+     {
+      std::swap(m_allocator,r.m_allocator);
+      std::swap(m_memory   ,r.m_memory   );
+      std::swap(m_ctrl     ,r.m_ctrl     );
+      std::swap(m_slots    ,r.m_slots    );
+      std::swap(m_count    ,r.m_count    );
+      std::swap(m_filled   ,r.m_filled   );
+      std::swap(m_deleted  ,r.m_deleted  );
+      std::swap(m_mask     ,r.m_mask     );
+      return *this;
+     }
+   //+------------------------------------------------------------------+
+   //| Allocator                                                        |
+   //+------------------------------------------------------------------+
+   TAllocator& Allocator(void)
+     {
+      return(m_allocator);
+     }
+   //+------------------------------------------------------------------+
+   //| Inserting an element in the hash creating an instance of         |
+   //| the TValue class                                                 |
+   //+------------------------------------------------------------------+
+   template <typename... TArgs>
+   TValue* Insert(TArgs&&... args)
+     {
+      //--- if rebuild is required
+      if(!Grow())
+         return(nullptr);
+      //--- construct on stack, the hash is calculated by the value
+      TValue         obj{std::forward<TArgs>(args)...};
+      const uint64_t hash=Mix(m_hash(obj));
+      //--- check for duplicates
+      if(FindIndex(hash,obj)!=INVALID_INDEX)
+         return(nullptr);
+      //--- no duplicates, insert
+      const uint64_t idx=FindFreeIndex(hash);
+      SetCtrl(idx,hash);
+      return(new (m_slots+idx) TValue(std::move(obj)));
+     }
+   //+------------------------------------------------------------------+
+   //| Find or insert new item                                          |
+   //+------------------------------------------------------------------+
+   template <typename... TArgs>
+   TValue* FindOrInsert(TArgs&&... args)
+     {
+      //--- calculate the hash
+      const uint64_t hash=Mix(m_hash(std::forward<TArgs>(args)...));
+      //--- table check
+      if(m_count)
+        {
+         const uint64_t idx=FindIndex(hash,std::forward<TArgs>(args)...);
+         if(idx!=INVALID_INDEX)
+            return(m_slots+idx);
+        }
+      //--- item not found, check rebuild is required
+      if(!Grow())
+         return(nullptr);
+      //--- construct in place
+      const uint64_t idx=FindFreeIndex(hash);
+      SetCtrl(idx,hash);
+      return(new (m_slots+idx) TValue{std::forward<TArgs>(args)...});
+     }
+   //+------------------------------------------------------------------+
+   //| Search for the element                                           |
+   //+------------------------------------------------------------------+
+   template <typename... TArgs>
+   TValue* Find(TArgs&&... args) const
+     {
+      if(m_count<=0)
+         return(nullptr);
+      //--- calculate hash and probe groups
+      const uint64_t idx=FindIndex(Mix(m_hash(std::forward<TArgs>(args)...)),std::forward<TArgs>(args)...);
+      return(idx!=INVALID_INDEX ? m_slots+idx : nullptr);
+     }
+   //+------------------------------------------------------------------+
+   //| Delete the 1st and only the 1st element                          |
+   //+------------------------------------------------------------------+
+   template <typename... TArgs>
+   bool Remove(TArgs&&... args)
+     {
+      if(m_count<=0)
+         return(false);
+      //--- search
+      const uint64_t idx=FindIndex(Mix(m_hash(std::forward<TArgs>(args)...)),std::forward<TArgs>(args)...);
+      if(idx==INVALID_INDEX)
+         return(false);
+      //--- destroy
+      m_slots[idx].~TValue();
+      m_filled--;
+      //--- if the group has an empty slot, no probe sequence has passed through it, mark slot empty
+      if(MatchEmpty(m_ctrl+(idx & ~(GROUP_WIDTH-1))))
+         m_ctrl[idx]=CTRL_EMPTY;
+      else
+        {
+         m_ctrl[idx]=CTRL_DELETED;
+         m_deleted++;
+        }
+      return(true);
+     }
+   //+------------------------------------------------------------------+
+   //| Preparing a table of a predetermined size                        |
+   //+------------------------------------------------------------------+
+   bool Reserve(uint64_t count)
+     {
+      uint64_t mult=COUNT_MIN;
+      //--- calculate the power of two with the load factor
+      while(MaxLoad(mult) < count)
+         mult*=2;
+      //--- rebuild the table
+      if(mult<=m_count)
+         return(false);
+      return(RebuildTable(mult));
+     }
+   //+------------------------------------------------------------------+
+   //| Clear the table and free all allocated memory                    |
+   //+------------------------------------------------------------------+
+   void Shutdown(void)
+     {
+      //--- free memory
+      if(m_memory)
+        {
+         //--- pass through all the elements
+         for(uint64_t idx=NextFull(m_ctrl,m_count,0); idx<m_count; idx=NextFull(m_ctrl,m_count,idx+1))
+            m_slots[idx].~TValue();
+         //---
+         m_allocator.Free(m_memory);
+         m_memory=nullptr;
+        }
+      //---
+      m_ctrl   =nullptr;
+      m_slots  =nullptr;
+      m_count  =0;
+      m_filled =0;
+      m_deleted=0;
+      m_mask   =0;
+     }
+   //+------------------------------------------------------------------+
+   //| Iterate over each element in the hash,                           |
+   //| through the passed functor                                       |
+   //+------------------------------------------------------------------+
+   template <typename TIterator, typename... TArgs>
+   void Iterate(TIterator &&iterator, TArgs&&... args)
+     {
+      for(uint64_t idx=NextFull(m_ctrl,m_count,0); idx<m_count; idx=NextFull(m_ctrl,m_count,idx+1))
+        {
+         //--- pass the call to the functor with additional parameters
+         if(!iterator(m_slots[idx], std::forward<TArgs>(args)...))
+            return;
+        }
+     }
+   //+------------------------------------------------------------------+
+   //| Number of elements                                               |
+   //+------------------------------------------------------------------+
+   uint64_t Size(void) const
+     {
+      return(m_filled);
+     }
+   //+------------------------------------------------------------------+
+   //| Iteration                                                        |
+   //+------------------------------------------------------------------+
+   Iterator          begin(void)             { return{m_ctrl,m_slots,m_count}; }
+   ConstIterator     begin(void) const       { return{m_ctrl,m_slots,m_count}; }
+   constexpr Iterator end(void)              { return{}; }
+   constexpr ConstIterator end(void) const   { return{}; }
+
+private:
+   //--- prohibit copy constructor and assignment
+                     TMTFlatHashTable(const TMTFlatHashTable&)=delete;
+   const TMTFlatHashTable& operator=(const TMTFlatHashTable&)=delete;
+   //+------------------------------------------------------------------+
+   //| Mix the "raw" hash, functors often return the key itself         |
+   //+------------------------------------------------------------------+
+   static uint64_t Mix(uint64_t hash)
+     {
+      hash^=hash >> 33;
+      hash*=0xff51afd7ed558ccdULL;
+      hash^=hash >> 33;
+      return(hash);
+     }
+   //+------------------------------------------------------------------+
+   //| Maximal number of used slots for the table size (7/8)            |
+   //+------------------------------------------------------------------+
+   static uint64_t MaxLoad(const uint64_t count)
+     {
+      return(count - count/8);
+     }
+   //+------------------------------------------------------------------+
+   //| Index of the lowest bit set                                      |
+   //+------------------------------------------------------------------+
+   static uint32_t LowestBit(const uint32_t mask)
+     {
+#if defined(_MSC_VER)
+      unsigned long idx=0;
+      _BitScanForward(&idx,mask);
+      return(uint32_t(idx));
+#else
+      return(uint32_t(__builtin_ctz(mask)));
+#endif
+     }
+   //+------------------------------------------------------------------+
+   //| Bit mask of the group slots with the hash control byte           |
+   //+------------------------------------------------------------------+
+   static uint32_t Match(const int8_t *group,const int8_t h2)
+     {
+#ifdef MTAPI_FLAT_HASH_SSE2
+      const __m128i ctrl=_mm_loadu_si128((const __m128i*)group);
+      return(uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2),ctrl))));
+#else
+      uint32_t mask=0;
+      for(uint32_t i=0; i<GROUP_WIDTH; i++)
+         if(group[i]==h2)
+            mask|=1u << i;
+      return(mask);
+#endif
+     }
+   //+------------------------------------------------------------------+
+   //| Bit mask of the group empty slots                                |
+   //+------------------------------------------------------------------+
+   static uint32_t MatchEmpty(const int8_t *group)
+     {
+      return(Match(group,CTRL_EMPTY));
+     }
+   //+------------------------------------------------------------------+
+   //| Bit mask of the group empty or deleted slots                     |
+   //+------------------------------------------------------------------+
+   static uint32_t MatchFree(const int8_t *group)
+     {
+#ifdef MTAPI_FLAT_HASH_SSE2
+      //--- both CTRL_EMPTY and CTRL_DELETED have the high bit set
+      return(uint32_t(_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)group))));
+#else
+      uint32_t mask=0;
+      for(uint32_t i=0; i<GROUP_WIDTH; i++)
+         if(group[i]<0)
+            mask|=1u << i;
+      return(mask);
+#endif
+     }
+   //+------------------------------------------------------------------+
+   //| Index of the first full slot starting from index                 |
+   //| returns count if nothing found                                   |
+   //+------------------------------------------------------------------+
+   static uint64_t NextFull(const int8_t *ctrl,const uint64_t count,uint64_t index)
+     {
+      //--- the rest of the current group
+      if(index<count && (index & (GROUP_WIDTH-1)))
+        {
+         const uint64_t group=index & ~(GROUP_WIDTH-1);
+         const uint32_t mask =(~MatchFree(ctrl+group) & 0xFFFF) >> (index-group);
+         if(mask)
+            return(index+LowestBit(mask));
+         index=group+GROUP_WIDTH;
+        }
+#ifdef MTAPI_FLAT_HASH_AVX2
+      //--- skip the sparse areas by 2 groups at once
+      for(; index+GROUP_WIDTH*2<=count; index+=GROUP_WIDTH*2)
+        {
+         const uint32_t mask=~uint32_t(_mm256_movemask_epi8(_mm256_loadu_si256((const __m256i*)(ctrl+index))));
+         if(mask)
+            return(index+LowestBit(mask));
+        }
+#endif
+      //--- whole groups
+      for(; index<count; index+=GROUP_WIDTH)
+        {
+         const uint32_t mask=~MatchFree(ctrl+index) & 0xFFFF;
+         if(mask)
+            return(index+LowestBit(mask));
+        }
+      return(count);
+     }
+   //+------------------------------------------------------------------+
+   //| Index of the element or INVALID_INDEX                            |
+   //| triangular probing by groups visits each group exactly once      |
+   //+------------------------------------------------------------------+
+   template <typename... TArgs>
+   uint64_t FindIndex(const uint64_t hash,TArgs&&... args) const
+     {
+      const int8_t h2=int8_t(hash & 0x7F);
+      uint64_t     group=(hash >> 7) & m_mask;
+      //--- probe groups
+      for(uint64_t step=1; step<=m_mask+1; step++)
+        {
+         const int8_t *ctrl=m_ctrl+group*GROUP_WIDTH;
+         //--- check all candidates of the group
+         for(uint32_t mask=Match(ctrl,h2); mask; mask&=mask-1)
+           {
+            const uint64_t idx=group*GROUP_WIDTH+LowestBit(mask);
+            if(m_equal(m_slots[idx], std::forward<TArgs>(args)...))
+               return(idx);
+           }
+         //--- an empty slot terminates the probe sequence
+         if(MatchEmpty(ctrl))
+            break;
+         group=(group+step) & m_mask;
+        }
+      //--- nothing found
+      return(INVALID_INDEX);
+     }
+   //+------------------------------------------------------------------+
+   //| Index of the first empty or deleted slot in the probe sequence   |
+   //+------------------------------------------------------------------+
+   uint64_t FindFreeIndex(const uint64_t hash) const
+     {
+      uint64_t group=(hash >> 7) & m_mask;
+      //--- the table always has free slots due to the load factor
+      for(uint64_t step=1;; step++)
+        {
+         const uint32_t mask=MatchFree(m_ctrl+group*GROUP_WIDTH);
+         if(mask)
+            return(group*GROUP_WIDTH+LowestBit(mask));
+         group=(group+step) & m_mask;
+        }
+     }
+   //+------------------------------------------------------------------+
+   //| Mark the free slot as used                                       |
+   //+------------------------------------------------------------------+
+   void SetCtrl(const uint64_t idx,const uint64_t hash)
+     {
+      if(m_ctrl[idx]==CTRL_DELETED)
+         m_deleted--;
+      m_ctrl[idx]=int8_t(hash & 0x7F);
+      m_filled++;
+     }
+   //+------------------------------------------------------------------+
+   //| Check room for one more element, rebuild if necessary            |
+   //+------------------------------------------------------------------+
+   bool Grow(void)
+     {
+      //--- first allocation
+      if(m_count<=0)
+         return(RebuildTable(COUNT_INITIAL));
+      //--- there is room
+      if(m_filled+m_deleted < MaxLoad(m_count))
+         return(true);
+      //--- a lot of tombstones, just clean them up keeping the size
+      if(m_filled*2 < MaxLoad(m_count))
+         return(RebuildTable(m_count));
+      //--- double the table
+      return(RebuildTable(m_count*2));
+     }
+   //+------------------------------------------------------------------+
+   //| Rebuild the table                                                |
+   //+------------------------------------------------------------------+
+   bool RebuildTable(const uint64_t new_count)
+     {
+      if(new_count<m_count || new_count<COUNT_MIN)
+         return(false);
+      //--- allocate memory for the new table
+      const uint64_t ctrl_size=(new_count + SLOTS_ALIGN - 1) & ~(SLOTS_ALIGN-1);
+      void          *new_memory=m_allocator.Allocate(size_t(ctrl_size + sizeof(TValue) * new_count));
+      if(new_memory==nullptr)
+         return(false);
+      int8_t        *new_ctrl =(int8_t*)new_memory;
+      TValue        *new_slots=(TValue*)((uint8_t*)new_memory + ctrl_size);
+      //--- all slots are empty
+      memset(new_ctrl, CTRL_EMPTY, size_t(new_count));
+      //--- swap tables
+      void          *old_memory=m_memory;
+      int8_t        *old_ctrl  =m_ctrl;
+      TValue        *old_slots =m_slots;
+      const uint64_t old_count =m_count;
+      m_memory =new_memory;
+      m_ctrl   =new_ctrl;
+      m_slots  =new_slots;
+      m_count  =new_count;
+      m_mask   =new_count/GROUP_WIDTH - 1;
+      m_filled =0;
+      m_deleted=0;
+      //--- if there is something to move
+      if(old_memory)
+        {
+         for(uint64_t idx=NextFull(old_ctrl,old_count,0); idx<old_count; idx=NextFull(old_ctrl,old_count,idx+1))
+           {
+            //--- no duplicates here, insert into the new table directly
+            const uint64_t hash=Mix(m_hash(old_slots[idx]));
+            const uint64_t pos =FindFreeIndex(hash);
+            SetCtrl(pos,hash);
+            new (m_slots+pos) TValue(std::move(old_slots[idx]));
+            old_slots[idx].~TValue();
+           }
+         //--- release old
+         m_allocator.Free(old_memory);
+        }
+      //---
+      return(true);
+     }
+  };
+//+------------------------------------------------------------------+
@@ -956,4 +956,415 @@ inline void SMTFormat::TrimZeros(CMTStr &str,uint32_t extra_digits)
    if(len>0 && str[len-1]==L'.')
       str.Trim(len-1);
   }
-//+------------------------------------------------------------------+
\ No newline at end of file
+//+------------------------------------------------------------------+
+//| Fast formatting into raw buffers without allocations             |
+//| for char (ASCII, valid UTF-8) and wchar_t buffers                |
+//| all functions write terminating zero and return pointer to it,   |
+//| so calls can be chained to build a line                          |
+//| numbers require NUMBER_LEN_MAX characters, dates DATE_LEN_MAX    |
+//+------------------------------------------------------------------+
+class SMTFormatFast
+  {
+public:
+   //--- constants
+   enum constants
+     {
+      NUMBER_LEN_MAX =64,                  // enough for any number
+      DATE_LEN_MAX   =32,                  // enough for any date & time
+     };
+
+private:
+   //--- constants
+   enum
+     {
+      SIG_DECIMAL    ='.',
+      SIG_NEGATIVE   ='-',
+      SIG_THOUSAND   =' ',
+      DIGITS_MAX     =19,                  // maximum digits of fractional part
+     };
+   //--- two digits table
+   static const char s_digits2[201];
+   //--- powers of 10
+   static const uint64_t s_pow10[20];
+
+public:
+   //--- integers
+   template <typename TChar> static TChar* UInt(TChar *out,uint64_t val);
+   template <typename TChar> static TChar* Int(TChar *out,int64_t val);
+   //--- fixed point number mantissa*10^-digits
+   template <typename TChar> static TChar* Price(TChar *out,int64_t mantissa,uint32_t digits);
+   template <typename TChar> static TChar* Money(TChar *out,int64_t mantissa,uint32_t digits);
+   //--- doubles, the same output as SMTFormat::FormatDouble and FormatMoney for digits<=8,
+   //--- more digits are printed while SMTFormat returns an empty string
+   template <typename TChar> static TChar* Price(TChar *out,double val,uint32_t digits);
+   template <typename TChar> static TChar* Money(TChar *out,double val,uint32_t digits);
+   //--- date & time as YYYY.MM.DD HH:MM:SS, date separator may be changed
+   template <typename TChar> static TChar* Date(TChar *out,const tm &ttm,const char separator='.');
+   template <typename TChar> static TChar* Time(TChar *out,const tm &ttm,bool use_sec=false);
+   template <typename TChar> static TChar* DateTime(TChar *out,const tm &ttm,bool use_sec=false,const char separator='.');
+   template <typename TChar> static TChar* DateTime(TChar *out,int64_t ctm,bool use_sec=false,const char separator='.');
+   template <typename TChar> static TChar* DateTimeMsc(TChar *out,int64_t ctm,const char separator='.');
+   //--- string and character
+   template <typename TChar> static TChar* Copy(TChar *out,const TChar *str);
+   template <typename TChar> static TChar* Char(TChar *out,const TChar character);
+
+private:
+   //--- write exactly count digits before end
+   template <typename TChar> static void  Digits(TChar *end,uint64_t val,uint32_t count);
+   template <typename TChar> static void  Digits2(TChar *out,uint32_t val);
+   static uint32_t   DigitsCount(const uint64_t val);
+   //--- thousands separated integer
+   template <typename TChar> static TChar* UIntThousands(TChar *out,uint64_t val);
+   //--- CRT formatting of out of range values
+   static char*      Printf(char *out,const double val,const uint32_t digits);
+   static wchar_t*   Printf(wchar_t *out,const double val,const uint32_t digits);
+   template <typename TChar> static TChar* InsertThousands(TChar *out,TChar *end);
+  };
+//+------------------------------------------------------------------+
+//| Two digits table                                                 |
+//+------------------------------------------------------------------+
+const __declspec(selectany) char SMTFormatFast::s_digits2[201]=
+   "0001020304050607080910111213141516171819"
+   "2021222324252627282930313233343536373839"
+   "4041424344454647484950515253545556575859"
+   "6061626364656667686970717273747576777879"
+   "8081828384858687888990919293949596979899";
+//+------------------------------------------------------------------+
+//| Powers of 10                                                     |
+//+------------------------------------------------------------------+
+const __declspec(selectany) uint64_t SMTFormatFast::s_pow10[20]=
+  {
+   1ULL,10ULL,100ULL,1000ULL,10000ULL,100000ULL,1000000ULL,10000000ULL,100000000ULL,1000000000ULL,
+   10000000000ULL,100000000000ULL,1000000000000ULL,10000000000000ULL,100000000000000ULL,
+   1000000000000000ULL,10000000000000000ULL,100000000000000000ULL,1000000000000000000ULL,10000000000000000000ULL
+  };
+//+------------------------------------------------------------------+
+//| Unsigned integer                                                 |
+//+------------------------------------------------------------------+
+template <typename TChar>
+inline TChar* SMTFormatFast::UInt(TChar *out,uint64_t val)
+  {
+   uint32_t count=DigitsCount(val);
+//--- digits from the end
+   Digits(out+count,val,count);
+   out[count]=0;
+//---
+   return(out+count);
+  }
+//+------------------------------------------------------------------+
+//| Signed integer                                                   |
+//+------------------------------------------------------------------+
+template <typename TChar>
+inline TChar* SMTFormatFast::Int(TChar *out,int64_t val)
+  {
+   if(val<0)
+     {
+      *out++=TChar(SIG_NEGATIVE);
+      return(UInt(out,0-uint64_t(val)));
+     }
+   return(UInt(out,uint64_t(val)));
+  }
+//+------------------------------------------------------------------+
+//| Fixed point price                                                |
+//+------------------------------------------------------------------+
+template <typename TChar>
+inline TChar* SMTFormatFast::Price(TChar *out,int64_t mantissa,uint32_t digits)
+  {
+   uint64_t val=uint64_t(mantissa);
+//--- sign
+   if(mantissa<0)
+     {
+      *out++=TChar(SIG_NEGATIVE);
+      val   =0-val;
+     }
+   if(digits>DIGITS_MAX)
+      digits=DIGITS_MAX;
+//--- integer part
+   out=UInt(out,val/s_pow10[digits]);
+//--- fractional part with leading zeros
+   if(digits>0)
+     {
+      *out++=TChar(SIG_DECIMAL);
+      Digits(out+digits,val%s_pow10[digits],digits);
+      out+=digits;
+      *out=0;
+     }
+//---
+   return(out);
+  }
+//+------------------------------------------------------------------+
+//| Fixed point money with thousands separators                      |
+//+------------------------------------------------------------------+
+template <typename TChar>
+inline TChar* SMTFormatFast::Money(TChar *out,int64_t mantissa,uint32_t digits)
+  {
+   uint64_t val=uint64_t(mantissa);
+//--- sign
+   if(mantissa<0)
+     {
+      *out++=TChar(SIG_NEGATIVE);
+      val   =0-val;
+     }
+   if(digits>DIGITS_MAX)
+      digits=DIGITS_MAX;
+//--- integer part
+   out=UIntThousands(out,val/s_pow10[digits]);
+//--- fractional part with leading zeros
+   if(digits>0)
+     {
+      *out++=TChar(SIG_DECIMAL);
+      Digits(out+digits,val%s_pow10[digits],digits);
+      out+=digits;
+      *out=0;
+     }
+//---
+   return(out);
+  }
+//+------------------------------------------------------------------+
+//| Price                                                            |
+//| digits are limited by 10, for 9 and 10 digits the value is       |
+//| printed unlike SMTFormat::FormatDouble returning empty string    |
+//+------------------------------------------------------------------+
+template <typename TChar>
+inline TChar* SMTFormatFast::Price(TChar *out,double val,uint32_t digits)
+  {
+   uint32_t digits_int=(digits<10)?digits:10;
+//--- convert to integer
+   double valdec=val*SMTMath::DecPow((int)digits_int);
+//--- check size
+   if(valdec>=double(_I64_MAX/100i64) || valdec<=double(_I64_MIN/100i64))
+      return(Printf(out,val,digits_int));
+//--- negative values are rounded from zero
+   if(val<0)
+     {
+      *out++=TChar(SIG_NEGATIVE);
+      return(Price(out,int64_t(0.5-valdec),digits_int));
+     }
+   return(Price(out,int64_t(valdec+0.5),digits_int));
+  }
+//+------------------------------------------------------------------+
+//| Money                                                            |
+//| digits are limited by DIGITS_MAX, for more than 8 digits the     |
+//| value is printed unlike SMTFormat::FormatMoney returning empty   |
+//| string                                                           |
+//+------------------------------------------------------------------+
+template <typename TChar>
+inline TChar* SMTFormatFast::Money(TChar *out,double val,uint32_t digits)
+  {
+   if(digits>DIGITS_MAX)
+      digits=DIGITS_MAX;
+//--- convert to integer
+   double valdec=val*SMTMath::DecPow((int)digits);
+//--- check size
+   if(valdec>=double(_I64_MAX/100i64) || valdec<=double(_I64_MIN/100i64))
+      return(InsertThousands(out,Printf(out,val,digits)));
+//--- negative values are rounded from zero
+   if(val<0)
+     {
+      *out++=TChar(SIG_NEGATIVE);
+      return(Money(out,int64_t(0.5-valdec),digits));
+     }
+   return(Money(out,int64_t(valdec+0.5),digits));
+  }
+//+------------------------------------------------------------------+
+//| Date                                                             |
+//+------------------------------------------------------------------+
+template <typename TChar>
+inline TChar* SMTFormatFast::Date(TChar *out,const tm &ttm,const char separator)
+  {
+   uint32_t year=uint32_t(ttm.tm_year+1900);
+//--- YYYY.MM.DD
+   Digits2(out,(year/100)%100);
+   Digits2(out+2,year%100);
+   out[4]=TChar(separator);
+   Digits2(out+5,uint32_t(ttm.tm_mon+1));
+   out[7]=TChar(separator);
+   Digits2(out+8,uint32_t(ttm.tm_mday));
+   out[10]=0;
+//---
+   return(out+10);
+  }
+//+------------------------------------------------------------------+
+//| Time                                                             |
+//+------------------------------------------------------------------+
+template <typename TChar>
+inline TChar* SMTFormatFast::Time(TChar *out,const tm &ttm,bool use_sec)
+  {
+//--- HH:MM
+   Digits2(out,uint32_t(ttm.tm_hour));
+   out[2]=TChar(':');
+   Digits2(out+3,uint32_t(ttm.tm_min));
+   out+=5;
+//--- :SS
+   if(use_sec)
+     {
+      out[0]=TChar(':');
+      Digits2(out+1,uint32_t(ttm.tm_sec));
+      out+=3;
+     }
+   *out=0;
+//---
+   return(out);
+  }
+//+------------------------------------------------------------------+
+//| Date & time                                                      |
+//+------------------------------------------------------------------+
+template <typename TChar>
+inline TChar* SMTFormatFast::DateTime(TChar *out,const tm &ttm,bool use_sec,const char separator)
+  {
+   out=Date(out,ttm,separator);
+   *out++=TChar(' ');
+   return(Time(out,ttm,use_sec));
+  }
+//+------------------------------------------------------------------+
+//| Date & time, nothing is written for invalid time                 |
+//+------------------------------------------------------------------+
+template <typename TChar>
+inline TChar* SMTFormatFast::DateTime(TChar *out,int64_t ctm,bool use_sec,const char separator)
+  {
+   tm ttm={};
+//--- parse
+   *out=0;
+   if(!SMTTime::ParseTime(ctm,&ttm))
+      return(out);
+//---
+   return(DateTime(out,ttm,use_sec,separator));
+  }
+//+------------------------------------------------------------------+
+//| Date & time with milliseconds                                    |
+//+------------------------------------------------------------------+
+template <typename TChar>
+inline TChar* SMTFormatFast::DateTimeMsc(TChar *out,int64_t ctm,const char separator)
+  {
+   tm ttm={};
+//--- parse
+   *out=0;
+   if(!SMTTime::ParseTime(ctm/1000,&ttm))
+      return(out);
+//--- .MSC
+   out=DateTime(out,ttm,true,separator);
+   *out++=TChar(SIG_DECIMAL);
+   Digits(out+3,uint64_t(ctm%1000),3);
+   out[3]=0;
+//---
+   return(out+3);
+  }
+//+------------------------------------------------------------------+
+//| Copy string                                                      |
+//+------------------------------------------------------------------+
+template <typename TChar>
+inline TChar* SMTFormatFast::Copy(TChar *out,const TChar *str)
+  {
+   if(str)
+      while(*str)
+         *out++=*str++;
+   *out=0;
+//---
+   return(out);
+  }
+//+------------------------------------------------------------------+
+//| Single character                                                 |
+//+------------------------------------------------------------------+
+template <typename TChar>
+inline TChar* SMTFormatFast::Char(TChar *out,const TChar character)
+  {
+   out[0]=character;
+   out[1]=0;
+//---
+   return(out+1);
+  }
+//+------------------------------------------------------------------+
+//| Write exactly count digits before end, two at a time             |
+//+------------------------------------------------------------------+
+template <typename TChar>
+inline void SMTFormatFast::Digits(TChar *end,uint64_t val,uint32_t count)
+  {
+   for(; count>=2; count-=2)
+     {
+      const char *pair=s_digits2+(val%100)*2;
+      val/=100;
+      end-=2;
+      end[0]=TChar(pair[0]);
+      end[1]=TChar(pair[1]);
+     }
+   if(count)
+      end[-1]=TChar('0'+val%10);
+  }
+//+------------------------------------------------------------------+
+//| Two digits                                                       |
+//+------------------------------------------------------------------+
+template <typename TChar>
+inline void SMTFormatFast::Digits2(TChar *out,uint32_t val)
+  {
+   const char *pair=s_digits2+(val%100)*2;
+   out[0]=TChar(pair[0]);
+   out[1]=TChar(pair[1]);
+  }
+//+------------------------------------------------------------------+
+//| Count of decimal digits                                          |
+//+------------------------------------------------------------------+
+inline uint32_t SMTFormatFast::DigitsCount(const uint64_t val)
+  {
+   uint32_t count=1;
+   while(count<20 && val>=s_pow10[count])
+      count++;
+   return(count);
+  }
+//+------------------------------------------------------------------+
+//| Unsigned integer with thousands separators                       |
+//+------------------------------------------------------------------+
+template <typename TChar>
+inline TChar* SMTFormatFast::UIntThousands(TChar *out,uint64_t val)
+  {
+   uint32_t count=DigitsCount(val);
+   uint32_t len  =count+(count-1)/3;
+   TChar   *end  =out+len;
+//--- groups of three digits from the end
+   *end=0;
+   for(; count>3; count-=3)
+     {
+      Digits(end,val%1000,3);
+      val/=1000;
+      end-=4;
+      *end=TChar(SIG_THOUSAND);
+     }
+   Digits(end,val,count);
+//---
+   return(out+len);
+  }
+//+------------------------------------------------------------------+
+//| CRT formatting                                                   |
+//+------------------------------------------------------------------+
+inline char* SMTFormatFast::Printf(char *out,const double val,const uint32_t digits)
+  {
+   int len=_snprintf_s(out,NUMBER_LEN_MAX,_TRUNCATE,"%.*f",int(digits),val);
+   return(out+(len>=0 ? len : NUMBER_LEN_MAX-1));
+  }
+inline wchar_t* SMTFormatFast::Printf(wchar_t *out,const double val,const uint32_t digits)
+  {
+   int len=_snwprintf_s(out,NUMBER_LEN_MAX,_TRUNCATE,L"%.*f",int(digits),val);
+   return(out+(len>=0 ? len : NUMBER_LEN_MAX-1));
+  }
+//+------------------------------------------------------------------+
+//| Insert thousands separators before decimal point                 |
+//+------------------------------------------------------------------+
+template <typename TChar>
+inline TChar* SMTFormatFast::InsertThousands(TChar *out,TChar *end)
+  {
+   TChar *point=end;
+//--- find decimal point
+   while(point>out && *point!=TChar(SIG_DECIMAL))
+      point--;
+   if(*point!=TChar(SIG_DECIMAL))
+      return(end);
+//--- move groups right
+   for(int64_t pos=(point-out)-3; pos>=3 && end-out<NUMBER_LEN_MAX-1; pos-=3)
+     {
+      memmove(out+pos+1,out+pos,sizeof(TChar)*(end-out-pos+1));
+      out[pos]=TChar(SIG_THOUSAND);
+      end++;
+     }
+//---
+   return(end);
+  }
+//+------------------------------------------------------------------+
@@ -0,0 +1,394 @@
+//+------------------------------------------------------------------+
+//|                                                 MetaTrader 5 API |
+//|                             Copyright 2000-2025, MetaQuotes Ltd. |
+//|                                               www.metaquotes.net |
+//+------------------------------------------------------------------+
+#pragma once
+#include <new.h>
+#include <wchar.h>
+#include "MT5APIStorage.h"
+#include "MT5APIHashTable.h"
+//+------------------------------------------------------------------+
+//| Compiled groups mask                                             |
+//| the mask list is parsed once, Check gives the same result as     |
+//| CMTStr::CheckGroupMask: any matched '!' template excludes,       |
+//| otherwise any matched template includes                          |
+//| templates without '*' and with the only trailing '*' are stored  |
+//| in prefix tree, other templates are split into '*'-segments      |
+//| optional results cache is bounded and direct mapped              |
+//+------------------------------------------------------------------+
+class CMTGroupMask
+  {
+public:
+   //--- constants
+   enum constants
+     {
+      CACHE_NAME_MAX=64,                  // maximum cached name length
+     };
+
+private:
+   //--- prefix tree node flags
+   enum EnNodeFlags
+     {
+      NODE_EXACT        =1,                // template ends here
+      NODE_EXACT_NOT    =2,                // '!' template ends here
+      NODE_PREFIX       =4,                // template with trailing '*' ends here
+      NODE_PREFIX_NOT   =8,                // '!' template with trailing '*' ends here
+      NODE_INCLUDE      =NODE_EXACT|NODE_PREFIX,
+      NODE_EXCLUDE      =NODE_EXACT_NOT|NODE_PREFIX_NOT,
+     };
+   //--- prefix tree node
+   struct Node
+     {
+      wchar_t           character;          // node character
+      uint32_t          flags;              // EnNodeFlags
+      uint32_t          child;              // first child, 0 - none
+      uint32_t          sibling;            // next sibling, 0 - none
+     };
+   //--- template segment, the text between '*'
+   struct Segment
+     {
+      uint32_t          offset;             // offset in text buffer
+      uint32_t          len;                // length
+     };
+   //--- template with '*' inside
+   struct Pattern
+     {
+      uint32_t          segment;            // first segment
+      uint32_t          segments;           // segments total
+      bool              anchor_begin;       // the first segment is at the beginning
+      bool              anchor_end;         // the last segment is at the end
+      bool              exclude;            // '!' template
+     };
+   //--- cache entry
+   struct CacheEntry
+     {
+      uint64_t          hash;               // name hash
+      uint32_t          len;                // name length, 0 - empty entry
+      bool              result;             // cached result
+      wchar_t           name[CACHE_NAME_MAX];
+     };
+   //--- arrays
+   typedef TMTArray<Node,256>    NodeArray;
+   typedef TMTArray<Segment>     SegmentArray;
+   typedef TMTArray<Pattern>     PatternArray;
+   typedef TMTArray<wchar_t,256> TextArray;
+
+private:
+   NodeArray         m_nodes;             // prefix tree, node 0 is the root
+   SegmentArray      m_segments;          // segments of patterns
+   PatternArray      m_patterns;          // patterns with '*' inside
+   TextArray         m_text;              // segments text
+   uint32_t          m_root_flags;        // NODE_PREFIX* of '*' templates
+   bool              m_exclude;           // there are '!' templates
+   //--- cache
+   mutable CacheEntry *m_cache;           // results cache
+   uint32_t          m_cache_mask;        // cache size - 1
+   mutable SRWLOCK   m_cache_lock;        // cache lock
+
+public:
+   //+------------------------------------------------------------------+
+   //| Constructor                                                      |
+   //+------------------------------------------------------------------+
+                     CMTGroupMask(void) : m_root_flags(0),m_exclude(false),m_cache(NULL),m_cache_mask(0)
+     {
+      InitializeSRWLock(&m_cache_lock);
+     }
+   //+------------------------------------------------------------------+
+   //| Destructor                                                       |
+   //+------------------------------------------------------------------+
+                    ~CMTGroupMask(void)
+     {
+      Shutdown();
+     }
+   //+------------------------------------------------------------------+
+   //| Free all memory                                                  |
+   //+------------------------------------------------------------------+
+   void Shutdown(void)
+     {
+      m_nodes.Shutdown();
+      m_segments.Shutdown();
+      m_patterns.Shutdown();
+      m_text.Shutdown();
+      m_root_flags=0;
+      m_exclude   =false;
+      //--- cache
+      if(m_cache)
+        {
+         delete[] m_cache;
+         m_cache=NULL;
+        }
+      m_cache_mask=0;
+     }
+   //+------------------------------------------------------------------+
+   //| Parse comma separated groups mask list,                          |
+   //| cache_size is rounded up to power of two, 0 - without cache      |
+   //+------------------------------------------------------------------+
+   bool Compile(LPCWSTR groupsmask,uint32_t cache_size=0)
+     {
+      wchar_t mask[256];
+      int32_t pos;
+      //--- clear
+      Shutdown();
+      //--- the root node
+      Node root={0,0,0,0};
+      if(!m_nodes.Add(&root))
+         return(false);
+      //--- the same tokenizer as CMTStr::CheckGroupMask
+      if(groupsmask)
+         for(const wchar_t *tok_start=groupsmask;*tok_start;tok_start++)
+           {
+            //--- skip spaces and commas
+            if(*tok_start==L' ' || *tok_start==L',')
+               continue;
+            //--- copy mask
+            for(pos=0; *tok_start && *tok_start!=L',' && pos<255; tok_start++,pos++)
+               mask[pos]=*tok_start;
+            //--- skip spaces and commas
+            while(pos>0 && (mask[pos-1]==L' ' || mask[pos-1]==L','))
+               pos--;
+            mask[pos]=0;
+            //--- add template
+            if(!TemplateAdd(mask))
+              {
+               Shutdown();
+               return(false);
+              }
+            //--- template over
+            if(!*tok_start)
+               break;
+           }
+      //--- allocate cache
+      if(cache_size>0)
+        {
+         uint32_t size=1;
+         while(size<cache_size && size<0x80000000)
+            size<<=1;
+         if((m_cache=new(std::nothrow) CacheEntry[size])==NULL)
+           {
+            Shutdown();
+            return(false);
+           }
+         for(uint32_t i=0; i<size; i++)
+            m_cache[i].len=0;
+         m_cache_mask=size-1;
+        }
+      //---
+      return(true);
+     }
+   //+------------------------------------------------------------------+
+   //| Check group correspondence to the compiled mask                  |
+   //+------------------------------------------------------------------+
+   bool Check(LPCWSTR group) const
+     {
+      //--- check
+      if(!group || m_nodes.Total()==0)
+         return(false);
+      //--- without cache
+      if(!m_cache)
+         return(Match(group));
+      //--- cache lookup, contention is resolved by matching without cache
+      size_t len=wcslen(group);
+      if(len==0 || len>=CACHE_NAME_MAX)
+         return(Match(group));
+      uint64_t    hash =MTWyHash::Calculate(group,len*sizeof(wchar_t),MTWyHash::SEED);
+      CacheEntry &entry=m_cache[hash & m_cache_mask];
+      if(TryAcquireSRWLockShared(&m_cache_lock))
+        {
+         bool found=entry.len==len && entry.hash==hash && wmemcmp(entry.name,group,len)==0;
+         bool res  =entry.result;
+         ReleaseSRWLockShared(&m_cache_lock);
+         if(found)
+            return(res);
+        }
+      //--- match and store result
+      bool res=Match(group);
+      if(TryAcquireSRWLockExclusive(&m_cache_lock))
+        {
+         entry.hash  =hash;
+         entry.len   =uint32_t(len);
+         entry.result=res;
+         wmemcpy(entry.name,group,len);
+         ReleaseSRWLockExclusive(&m_cache_lock);
+        }
+      //---
+      return(res);
+     }
+
+private:
+   //--- prohibit copy constructor and assignment
+                     CMTGroupMask(const CMTGroupMask&)=delete;
+   CMTGroupMask&     operator=(const CMTGroupMask&)=delete;
+   //+------------------------------------------------------------------+
+   //| Add single template                                              |
+   //+------------------------------------------------------------------+
+   bool TemplateAdd(const wchar_t *mask)
+     {
+      bool exclude=false;
+      //--- skip multiple '!'
+      for(; *mask=='!'; mask++)
+         exclude=true;
+      if(exclude)
+         m_exclude=true;
+      //--- count '*' groups and find the first one
+      const wchar_t *ast=NULL;
+      uint32_t       asts=0;
+      size_t         len=0;
+      for(; mask[len]; len++)
+         if(mask[len]=='*' && (len==0 || mask[len-1]!='*'))
+           {
+            if(!ast)
+               ast=mask+len;
+            asts++;
+           }
+      //--- any name, the empty template after '!' also matches any name
+      if(len==0 || (ast==mask && asts==1 && mask[len-1]=='*'))
+        {
+         m_root_flags|=exclude ? NODE_PREFIX_NOT : NODE_PREFIX;
+         return(true);
+        }
+      //--- exact or prefix template
+      if(asts==0)
+         return(NodeAdd(mask,len,exclude ? NODE_EXACT_NOT : NODE_EXACT));
+      if(asts==1 && ast!=mask && mask[len-1]=='*')
+         return(NodeAdd(mask,size_t(ast-mask),exclude ? NODE_PREFIX_NOT : NODE_PREFIX));
+      //--- pattern
+      Pattern pattern;
+      pattern.segment     =m_segments.Total();
+      pattern.segments    =0;
+      pattern.anchor_begin=mask[0]!='*';
+      pattern.anchor_end  =mask[len-1]!='*';
+      pattern.exclude     =exclude;
+      for(size_t i=0; i<len;)
+        {
+         //--- skip '*'
+         for(; i<len && mask[i]=='*'; i++) {}
+         if(i>=len)
+            break;
+         //--- segment
+         Segment segment;
+         segment.offset=m_text.Total();
+         for(segment.len=0; i<len && mask[i]!='*'; i++,segment.len++) {}
+         if(!m_text.Add(mask+i-segment.len,segment.len) || !m_segments.Add(&segment))
+            return(false);
+         pattern.segments++;
+        }
+      //---
+      return(m_patterns.Add(&pattern));
+     }
+   //+------------------------------------------------------------------+
+   //| Add prefix tree path                                             |
+   //+------------------------------------------------------------------+
+   bool NodeAdd(const wchar_t *text,size_t len,uint32_t flags)
+     {
+      uint32_t node=0;
+      //--- go down the tree, adding missing nodes
+      for(size_t i=0; i<len; i++)
+        {
+         uint32_t child=Child(node,text[i]);
+         if(!child)
+           {
+            Node add={text[i],0,0,m_nodes[node].child};
+            child=m_nodes.Total();
+            if(!m_nodes.Add(&add))
+               return(false);
+            m_nodes[node].child=child;
+           }
+         node=child;
+        }
+      m_nodes[node].flags|=flags;
+      //---
+      return(true);
+     }
+   //+------------------------------------------------------------------+
+   //| Child node by character                                          |
+   //+------------------------------------------------------------------+
+   uint32_t Child(uint32_t node,wchar_t character) const
+     {
+      const Node *nodes=&m_nodes[0];
+      for(uint32_t child=nodes[node].child; child; child=nodes[child].sibling)
+         if(nodes[child].character==character)
+            return(child);
+      return(0);
+     }
+   //+------------------------------------------------------------------+
+   //| Match group without cache                                        |
+   //+------------------------------------------------------------------+
+   bool Match(LPCWSTR group) const
+     {
+      const Node *nodes=&m_nodes[0];
+      uint32_t    flags=m_root_flags;
+      uint32_t    node =0;
+      bool        tree =true;
+      size_t      len  =0;
+      //--- go down the prefix tree collecting prefix templates
+      for(; group[len]; len++)
+         if(tree)
+           {
+            if((node=Child(node,group[len]))!=0)
+               flags|=nodes[node].flags & (NODE_PREFIX|NODE_PREFIX_NOT);
+            else
+               tree=false;
+           }
+      //--- the whole name is in the tree
+      if(tree)
+         flags|=nodes[node].flags & (NODE_EXACT|NODE_EXACT_NOT);
+      //--- exclusions first
+      if(flags & NODE_EXCLUDE)
+         return(false);
+      if(m_exclude)
+         for(uint32_t i=0; i<m_patterns.Total(); i++)
+            if(m_patterns[i].exclude && PatternMatch(m_patterns[i],group,len))
+               return(false);
+      //--- inclusions
+      if(flags & NODE_INCLUDE)
+         return(true);
+      for(uint32_t i=0; i<m_patterns.Total(); i++)
+         if(!m_patterns[i].exclude && PatternMatch(m_patterns[i],group,len))
+            return(true);
+      //---
+      return(false);
+     }
+   //+------------------------------------------------------------------+
+   //| Match pattern, segments are searched leftmost                    |
+   //+------------------------------------------------------------------+
+   bool PatternMatch(const Pattern &pattern,const wchar_t *group,size_t len) const
+     {
+      const Segment *segment=&m_segments[pattern.segment];
+      const Segment *last   =segment+pattern.segments;
+      const wchar_t *text   =&m_text[0];
+      size_t         pos    =0;
+      //--- the first segment at the beginning
+      if(pattern.anchor_begin)
+        {
+         if(segment->len>len || wmemcmp(group,text+segment->offset,segment->len)!=0)
+            return(false);
+         pos=segment->len;
+         segment++;
+        }
+      //--- the last segment at the end
+      if(pattern.anchor_end)
+        {
+         last--;
+         if(last->len>len-pos || wmemcmp(group+len-last->len,text+last->offset,last->len)!=0)
+            return(false);
+         len-=last->len;
+        }
+      //--- middle segments
+      for(; segment<last; segment++)
+        {
+         const wchar_t *seg=text+segment->offset;
+         for(;; pos++)
+           {
+            if(segment->len>len-pos)
+               return(false);
+            if(group[pos]==seg[0] && wmemcmp(group+pos,seg,segment->len)==0)
+               break;
+           }
+         pos+=segment->len;
+        }
+      //---
+      return(true);
+     }
+  };
+//+------------------------------------------------------------------+
@@ -6,12 +6,50 @@
 #pragma once
 #include <windows.h>
 #include <utility>
+#include <intrin.h>
+//+------------------------------------------------------------------+
+//| Memory policies of the hash allocator                            |
+//+------------------------------------------------------------------+
+//--- allocation granularity blocks, standard pages
+struct MTHashAllocatorDefault
+  {
+   static constexpr size_t ARENA_SIZE=0;            // block size for small items, 0 - allocation granularity
+   static constexpr bool   LARGE_PAGES=false;       // use large pages
+   static constexpr bool   NUMA_LOCAL=false;        // bind memory to the NUMA node of the owning thread
+  };
+//--- 2MB arenas on large pages, requires SeLockMemoryPrivilege, otherwise standard pages
+struct MTHashAllocatorLargePages
+  {
+   static constexpr size_t ARENA_SIZE=2*1024*1024;
+   static constexpr bool   LARGE_PAGES=true;
+   static constexpr bool   NUMA_LOCAL=false;
+  };
+//--- 2MB arenas on large pages of the NUMA node of the owning thread
+struct MTHashAllocatorLargePagesNuma
+  {
+   static constexpr size_t ARENA_SIZE=2*1024*1024;
+   static constexpr bool   LARGE_PAGES=true;
+   static constexpr bool   NUMA_LOCAL=true;
+  };
+//+------------------------------------------------------------------+
+//| Allocator counters                                               |
+//+------------------------------------------------------------------+
+struct MTHashAllocatorStats
+  {
+   uint64_t          blocks;              // blocks for small items
+   uint64_t          blocks_bytes;        // size of blocks for small items
+   uint64_t          free_items;          // free list length
+   uint64_t          direct;              // direct allocations
+   uint64_t          direct_bytes;        // size of direct allocations
+   bool              large_pages;         // large pages are used
+   uint32_t          numa_node;           // NUMA node, NUMA_NO_PREFERRED_NODE if not bound
+  };
 //+------------------------------------------------------------------+
 //| The default allocator for the hash                               |
 //| anything less than or equal to TSize is allocated via blocks     |
 //| in the list,  everything else via VirtualAlloc                   |
 //+------------------------------------------------------------------+
-template <uint32_t TSize>
+template <uint32_t TSize, typename TPolicy=MTHashAllocatorDefault>
 class TMTHashAllocator final
   {
 private:
@@ -22,6 +60,7 @@ private:
    struct alignas(8) BlockHeader
      {
       BlockHeader      *next;
+      size_t            size;
      };
    //--- free element
    struct ListItem
@@ -32,6 +71,15 @@ private:
    BlockHeader      *m_block=nullptr;         // list of blocks
    ListItem         *m_first=nullptr;         // the first free item in the list (this is one of the items in the block)
    uint32_t          m_granularity=0;         // alignment
+   uint32_t          m_page_size=0;           // standard page size
+   size_t            m_block_size=0;          // size of blocks for small items
+   size_t            m_large_page=0;          // large page size, 0 if large pages are not used
+   DWORD             m_numa_node=NUMA_NO_PREFERRED_NODE; // NUMA node
+   //--- counters
+   uint64_t          m_blocks=0;              // blocks for small items
+   uint64_t          m_free_items=0;          // free list length
+   uint64_t          m_direct=0;              // direct allocations
+   uint64_t          m_direct_bytes=0;        // size of direct allocations
 
 public:
    //+------------------------------------------------------------------+
@@ -42,6 +90,22 @@ public:
       SYSTEM_INFO si={};
       GetSystemInfo(&si);
       m_granularity=si.dwAllocationGranularity;
+      m_page_size  =si.dwPageSize;
+      //--- large pages, if supported by the system
+      if(TPolicy::LARGE_PAGES)
+         m_large_page=GetLargePageMinimum();
+      //--- the node of the processor of the owning thread
+      if(TPolicy::NUMA_LOCAL)
+        {
+         PROCESSOR_NUMBER processor={};
+         USHORT           node=0;
+         GetCurrentProcessorNumberEx(&processor);
+         if(GetNumaProcessorNodeEx(&processor, &node))
+            m_numa_node=node;
+        }
+      //--- block size is a multiple of the allocation granularity
+      m_block_size=TPolicy::ARENA_SIZE>m_granularity ? TPolicy::ARENA_SIZE : m_granularity;
+      m_block_size=(m_block_size + m_granularity - 1) & ~size_t(m_granularity - 1);
      }
    //+------------------------------------------------------------------+
    //| Destructor                                                       |
@@ -58,29 +122,45 @@ public:
       //--- IMPORTANT, you cannot replace VirtualAlloc with anything else here, you need m_granularity alignment
       //--- anything larger than TSize directly
       if(size > C_ALIGNED_SIZE)
-         return(VirtualAlloc(nullptr, size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE));
+        {
+         void *ptr=SystemAllocate(size);
+         if(ptr)
+           {
+            m_direct++;
+            m_direct_bytes+=size;
+           }
+         return(ptr);
+        }
       //--- If there are no free ones, we allocate
       if(m_first==nullptr)
         {
-         BlockHeader *new_block=(BlockHeader*)VirtualAlloc(nullptr, m_granularity, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+         size_t       block_size=m_block_size;
+         BlockHeader *new_block=(BlockHeader*)SystemAllocate(block_size);
          if(new_block==nullptr)
             return(nullptr);
          //--- add to the list of blocks
          new_block->next=m_block;
+         new_block->size=block_size;
          m_block=new_block;
+         m_blocks++;
 
          BYTE *mem=(BYTE*)new_block + sizeof(BlockHeader);
-         BYTE *mem_max=(BYTE*)new_block + m_granularity;
+         BYTE *mem_max=(BYTE*)new_block + block_size;
          //--- build a list of free ones in a new block
          for(; mem + C_ALIGNED_SIZE<=mem_max; mem+=C_ALIGNED_SIZE)
            {
+            //--- items of the large blocks must not be aligned, see Free
+            if((reinterpret_cast<uintptr_t>(mem)&(m_granularity-1))==0)
+               continue;
             ((ListItem*)mem)->next=m_first;
             m_first=((ListItem*)mem);
+            m_free_items++;
            }
         }
       //--- take 1 item
       void *temp=m_first;
       m_first=m_first->next;
+      m_free_items--;
       //---
       return(temp);
      }
@@ -96,9 +176,18 @@ public:
         {
          ((ListItem*)ptr)->next=m_first;
          m_first=(ListItem*)ptr;
+         m_free_items++;
         }
       else
+        {
+         //--- size of the direct allocation for the counters
+         MEMORY_BASIC_INFORMATION mbi={};
+         if(VirtualQuery(ptr, &mbi, sizeof(mbi)) && m_direct_bytes>=mbi.RegionSize)
+            m_direct_bytes-=mbi.RegionSize;
+         if(m_direct)
+            m_direct--;
          VirtualFree(ptr, 0, MEM_RELEASE);
+        }
      }
    //+------------------------------------------------------------------+
    //| Clearing, it is assumed that all blocks have already been freed  |
@@ -106,6 +195,8 @@ public:
    void Shutdown(void)
      {
       m_first=nullptr;
+      m_free_items=0;
+      m_blocks=0;
       //--- go through all the blocks and release
       while(m_block)
         {
@@ -114,6 +205,52 @@ public:
          VirtualFree(free_mem, 0, MEM_RELEASE);
         }
      }
+   //+------------------------------------------------------------------+
+   //| Counters                                                         |
+   //+------------------------------------------------------------------+
+   void Stats(MTHashAllocatorStats &stats) const
+     {
+      stats.blocks      =m_blocks;
+      stats.blocks_bytes=0;
+      for(const BlockHeader *block=m_block; block; block=block->next)
+         stats.blocks_bytes+=block->size;
+      stats.free_items  =m_free_items;
+      stats.direct      =m_direct;
+      stats.direct_bytes=m_direct_bytes;
+      stats.large_pages =m_large_page!=0;
+      stats.numa_node   =m_numa_node;
+     }
+
+private:
+   //+------------------------------------------------------------------+
+   //| Allocation of the system memory according to the policy,         |
+   //| the size is updated with the actually allocated one              |
+   //+------------------------------------------------------------------+
+   void* SystemAllocate(size_t &size)
+     {
+      void *ptr;
+      //--- large pages only for allocations not less than the page
+      if(m_large_page && size>=m_large_page)
+        {
+         const size_t large_size=(size + m_large_page - 1) & ~(m_large_page - 1);
+         if((ptr=SystemAllocate(large_size, MEM_COMMIT | MEM_RESERVE | MEM_LARGE_PAGES))!=nullptr)
+           {
+            size=large_size;
+            return(ptr);
+           }
+         //--- no privilege or physical memory is fragmented, don't try anymore
+         m_large_page=0;
+        }
+      //--- standard pages
+      size=(size + m_page_size - 1) & ~size_t(m_page_size - 1);
+      return(SystemAllocate(size, MEM_COMMIT | MEM_RESERVE));
+     }
+   void* SystemAllocate(const size_t size, const DWORD flags) const
+     {
+      if(m_numa_node!=NUMA_NO_PREFERRED_NODE)
+         return(VirtualAllocExNuma(GetCurrentProcess(), nullptr, size, flags, PAGE_READWRITE, m_numa_node));
+      return(VirtualAlloc(nullptr, size, flags, PAGE_READWRITE));
+     }
   };
 //+------------------------------------------------------------------+
 //| Functions for accumulative hashing                               |
@@ -225,16 +362,185 @@ uint64_t MTCalculateFNV1a(TArgs&&... args)
    return(MTFowlerNollVo::InnerCalculateFNV1a(14695981039346656037ULL, std::forward<TArgs>(args)...));
   }
 //+------------------------------------------------------------------+
+//| Functions for accumulative word-at-a-time hashing                |
+//| wyhash algorithm, 8-48 bytes per step instead of one byte of FNV |
+//| each Add hashes its data as a whole with the current hash as     |
+//| a seed, so Add(a)+Add(b) is not equal to Add(ab)                 |
+//+------------------------------------------------------------------+
+// https://github.com/wangyi-fudan/wyhash
+namespace MTWyHash
+  {
+   //--- default secret
+   constexpr uint64_t SECRET0=0x2d358dccaa6c78a5ULL;
+   constexpr uint64_t SECRET1=0x8bb84b93962eacc9ULL;
+   constexpr uint64_t SECRET2=0x4b33a62ed433d4a3ULL;
+   constexpr uint64_t SECRET3=0x4d5a2da51de1aa47ULL;
+   //--- initial hash value
+   constexpr uint64_t SEED=0x9e3779b97f4a7c15ULL;
+   //+------------------------------------------------------------------+
+   //| 64x64 to 128 bits multiplication, returns low and high parts     |
+   //+------------------------------------------------------------------+
+   inline void Mum(uint64_t &a, uint64_t &b)
+     {
+#if defined(_MSC_VER) && defined(_M_X64)
+      a=_umul128(a, b, &b);
+#elif defined(_MSC_VER)
+      const uint64_t lo=a * b;
+      b=__umulh(a, b);
+      a=lo;
+#else
+      const unsigned __int128 r=(unsigned __int128)a * b;
+      a=uint64_t(r);
+      b=uint64_t(r >> 64);
+#endif
+     }
+   //+------------------------------------------------------------------+
+   //| Multiply and fold                                                |
+   //+------------------------------------------------------------------+
+   inline uint64_t Mix(uint64_t a, uint64_t b)
+     {
+      Mum(a, b);
+      return(a ^ b);
+     }
+   //+------------------------------------------------------------------+
+   //| Unaligned reads                                                  |
+   //+------------------------------------------------------------------+
+   inline uint64_t Read8(const uint8_t *p) { uint64_t v; memcpy(&v, p, 8); return(v); }
+   inline uint64_t Read4(const uint8_t *p) { uint32_t v; memcpy(&v, p, 4); return(v); }
+   inline uint64_t Read3(const uint8_t *p, size_t k) { return((uint64_t(p[0]) << 16) | (uint64_t(p[k >> 1]) << 8) | p[k - 1]); }
+   //+------------------------------------------------------------------+
+   //| Hash of the data with the seed                                   |
+   //+------------------------------------------------------------------+
+   inline uint64_t Calculate(const void* data, size_t data_size, uint64_t seed)
+     {
+      const uint8_t *p=reinterpret_cast<const uint8_t*>(data);
+      uint64_t       a, b;
+      //---
+      seed^=Mix(seed ^ SECRET0, SECRET1);
+      if(data_size<=16)
+        {
+         if(data_size>=4)
+           {
+            a=(Read4(p) << 32) | Read4(p + ((data_size >> 3) << 2));
+            b=(Read4(p + data_size - 4) << 32) | Read4(p + data_size - 4 - ((data_size >> 3) << 2));
+           }
+         else
+           {
+            a=data_size>0 ? Read3(p, data_size) : 0;
+            b=0;
+           }
+        }
+      else
+        {
+         size_t idx=data_size;
+         //--- 48 bytes per step
+         if(idx>48)
+           {
+            uint64_t see1=seed, see2=seed;
+            do
+              {
+               seed=Mix(Read8(p) ^ SECRET1, Read8(p + 8) ^ seed);
+               see1=Mix(Read8(p + 16) ^ SECRET2, Read8(p + 24) ^ see1);
+               see2=Mix(Read8(p + 32) ^ SECRET3, Read8(p + 40) ^ see2);
+               p+=48;
+               idx-=48;
+              }
+            while(idx>48);
+            seed^=see1 ^ see2;
+           }
+         //--- 16 bytes per step
+         while(idx>16)
+           {
+            seed=Mix(Read8(p) ^ SECRET1, Read8(p + 8) ^ seed);
+            idx-=16;
+            p+=16;
+           }
+         a=Read8(p + idx - 16);
+         b=Read8(p + idx - 8);
+        }
+      //--- finalization
+      a^=SECRET1;
+      b^=seed;
+      Mum(a, b);
+      return(Mix(a ^ SECRET0 ^ data_size, b ^ SECRET1));
+     }
+   //+------------------------------------------------------------------+
+   //| Accumulative hash                                                |
+   //+------------------------------------------------------------------+
+   struct WyHash
+     {
+      uint64_t          hash=SEED;
+      //---
+      void Add(const void* data, size_t data_size)
+        {
+         hash=Calculate(data, data_size, hash);
+        }
+      //---
+      template<typename T> WyHash& Add(const T &value)
+        {
+         Add(&value,sizeof(T));
+         return *this;
+        }
+      //---
+      template<typename T> WyHash& AddValues(const T *values,const size_t total)
+        {
+         if(values)
+            Add(values,total*sizeof(T));
+         return *this;
+        }
+      //--- the whole string at once
+      template<typename TCHAR> void AddStr(const TCHAR* str)
+        {
+         size_t len=0;
+         while(str[len]!=0)
+            len++;
+         Add(str,len*sizeof(TCHAR));
+        }
+      uint64_t          Hash(void) const     { return(hash); }
+      operator          uint64_t(void) const   { return(hash); }
+     };
+   //+------------------------------------------------------------------+
+   //| Auxiliary wraps (completion)                                     |
+   //+------------------------------------------------------------------+
+   inline uint64_t InnerCalculate(uint64_t hash)
+     {
+      return(hash);
+     }
+   //+------------------------------------------------------------------+
+   //| Auxiliary wraps                                                  |
+   //+------------------------------------------------------------------+
+   template<typename... TArgs>
+   uint64_t InnerCalculate(uint64_t hash, const void* data, size_t data_size, TArgs&&... args)
+     {
+      hash=Calculate(data, data_size, hash);
+      //--- variadic recursion
+      return(InnerCalculate(hash, std::forward<TArgs>(args)...));
+     }
+  }
+//+------------------------------------------------------------------+
+//| Calculate hash in one-line hash via variadic template            |
+//| arguments are pairs of data pointer and size in bytes            |
+//+------------------------------------------------------------------+
+template<typename... TArgs>
+uint64_t MTCalculateWyHash(TArgs&&... args)
+  {
+   return(MTWyHash::InnerCalculate(MTWyHash::SEED, std::forward<TArgs>(args)...));
+  }
+//+------------------------------------------------------------------+
 //| Hash table with collision resolution via list                    |
 //| no duplicates                                                    |
 //| all previous references are valid after addition/deletion        |
 //| no duplicates, checks for duplicates                             |
+//| optional incremental rebuild: the old table is kept alive and    |
+//| its buckets are moved a few at a time by each modification       |
 //+------------------------------------------------------------------+
 template <typename TValue, typename THash, typename TEqual, typename TAllocator=TMTHashAllocator<sizeof(TValue)+16>>
 class TMTHashTable final
   {
    //--- constants
    static constexpr uint64_t COUNT_INITIAL=512;   // default initial table size
+   static constexpr size_t   BATCH_DISTANCE=16;   // batch search prefetch distance
+   static constexpr size_t   BATCH_SIZE    =64;   // batch search pipeline size, must be greater than 2*BATCH_DISTANCE
 
    //--- this structure is followed by TValue
    struct HashItem
@@ -252,13 +558,23 @@ public:
 
    private:
       HashItem        **m_table{};                 // table pointer
-      const HashItem *const *const m_table_end{};  // table end pointer
+      const HashItem *const *m_table_end{};        // table end pointer
       HashItem         *m_item{};                  // current item pointer
+      //--- incremental rebuild state
+      HashItem        **m_table_first{};           // new table pointer
+      uint64_t          m_valid_mask{};            // old table mask
+      uint64_t          m_valid_pos{};             // new table buckets are valid if (index & m_valid_mask)<m_valid_pos
+      HashItem        **m_table_next{};            // old table pointer
+      const HashItem *const *m_table_next_end{};   // old table end pointer
 
    public:
                         TIterator(void)=default;
       //--- constructor to iterate from the beginning of the table, moves to the first existing element
                         TIterator(HashItem **const table,const uint64_t size) : m_table{table},m_table_end{table+size} { operator++(); }
+      //--- constructor to iterate from the beginning of the new and old tables during incremental rebuild
+                        TIterator(HashItem **const table,const uint64_t size,HashItem **const table_old,const uint64_t size_old,const uint64_t rebuild_pos) :
+                           m_table{table},m_table_end{table+size},m_table_first{table},m_valid_mask{size_old-1},m_valid_pos{rebuild_pos},
+                           m_table_next{table_old},m_table_next_end{table_old+size_old} { operator++(); }
       //--- constructor to iterate from the found element in the table
                         TIterator(HashItem **const table,const HashItem *const *const table_end) : m_table{table},m_table_end{table_end},m_item{*table} {}
       //--- value
@@ -283,12 +599,25 @@ public:
            }
          //--- if we have reached the end of the collision list, we search for the next element in the hash table
          if(!m_item)
-            for(;m_table!=m_table_end;m_table++)
+            for(;;)
               {
-               m_item=*m_table;
-               //--- found the following non-empty entry in the hash table
-               if(m_item)
+               for(;m_table!=m_table_end;m_table++)
+                 {
+                  //--- skip not yet initialized buckets of the new table
+                  if(m_table_next && uint64_t((m_table-m_table_first) & m_valid_mask)>=m_valid_pos)
+                     continue;
+                  m_item=*m_table;
+                  //--- found the following non-empty entry in the hash table
+                  if(m_item)
+                     break;
+                 }
+               //--- go to the rest of the old table
+               if(m_item || !m_table_next)
                   break;
+               m_table         =m_table_next;
+               m_table_end     =m_table_next_end;
+               m_table_next    =nullptr;
+               m_table_next_end=nullptr;
               }
          return *this;
         }
@@ -306,6 +635,12 @@ private:
    uint64_t          m_count =0;          // current hash table size
    uint64_t          m_filled=0;          // number of elements (all including collisions)
    uint64_t          m_mask  =0;          // current mask calculated in advance
+   //--- incremental rebuild
+   HashItem        **m_table_old   =nullptr;  // old hash table
+   uint64_t          m_count_old   =0;        // old hash table size
+   uint64_t          m_mask_old    =0;        // old hash table mask
+   uint64_t          m_rebuild_pos =0;        // next old table bucket to move, new table buckets are valid if (index & m_mask_old)<m_rebuild_pos
+   uint64_t          m_rebuild_step=0;        // buckets moved per modification, 0 - rebuild the whole table at once
 
 public:
    //+------------------------------------------------------------------+
@@ -323,12 +658,17 @@ public:
    //+------------------------------------------------------------------+
    //| Move constructor                                                 |
    //+------------------------------------------------------------------+
-   TMTHashTable(TMTHashTable &&r) : m_allocator(std::move(r.m_allocator)),m_hash(std::move(r.m_hash)),m_equal(std::move(r.m_equal)),m_table(r.m_table),m_count(r.m_count),m_filled(r.m_filled),m_mask(r.m_mask)
+   TMTHashTable(TMTHashTable &&r) : m_allocator(std::move(r.m_allocator)),m_hash(std::move(r.m_hash)),m_equal(std::move(r.m_equal)),m_table(r.m_table),m_count(r.m_count),m_filled(r.m_filled),m_mask(r.m_mask),
+                                    m_table_old(r.m_table_old),m_count_old(r.m_count_old),m_mask_old(r.m_mask_old),m_rebuild_pos(r.m_rebuild_pos),m_rebuild_step(r.m_rebuild_step)
      {
       r.m_table =nullptr;
       r.m_count =0;
       r.m_filled=0;
       r.m_mask  =0;
+      r.m_table_old  =nullptr;
+      r.m_count_old  =0;
+      r.m_mask_old   =0;
+      r.m_rebuild_pos=0;
      }
    //+------------------------------------------------------------------+
    //| Destructor                                                       |
@@ -349,6 +689,11 @@ public:
       std::swap(m_count    ,r.m_count    );
       std::swap(m_filled   ,r.m_filled   );
       std::swap(m_mask     ,r.m_mask     );
+      std::swap(m_table_old   ,r.m_table_old   );
+      std::swap(m_count_old   ,r.m_count_old   );
+      std::swap(m_mask_old    ,r.m_mask_old    );
+      std::swap(m_rebuild_pos ,r.m_rebuild_pos );
+      std::swap(m_rebuild_step,r.m_rebuild_step);
       return *this;
      }
    //+------------------------------------------------------------------+
@@ -359,6 +704,33 @@ public:
       return(m_allocator);
      }
    //+------------------------------------------------------------------+
+   //| Incremental rebuild mode                                         |
+   //| number of old table buckets moved by each modification,          |
+   //| 0 - rebuild the whole table at once (default)                    |
+   //+------------------------------------------------------------------+
+   void IncrementalRebuild(const uint64_t buckets_per_operation)
+     {
+      m_rebuild_step=buckets_per_operation;
+      //--- blocking mode, complete the current rebuild
+      if(!m_rebuild_step)
+         RebuildComplete();
+     }
+   //+------------------------------------------------------------------+
+   //| Incremental rebuild is in progress                               |
+   //+------------------------------------------------------------------+
+   bool IsRebuilding(void) const
+     {
+      return(m_table_old!=nullptr);
+     }
+   //+------------------------------------------------------------------+
+   //| Complete the incremental rebuild                                 |
+   //+------------------------------------------------------------------+
+   void RebuildComplete(void)
+     {
+      if(m_table_old)
+         RebuildStep(m_count_old);
+     }
+   //+------------------------------------------------------------------+
    //| Inserting an element in the hash and creating an instance of     |
    //| the TOther class                                                 |
    //+------------------------------------------------------------------+
@@ -374,6 +746,9 @@ public:
    template <typename TOther=TValue, typename... TArgs>
    TOther* InsertEx(uint32_t extra_size, TArgs&&... args)
      {
+      //--- move a part of the old table
+      if(m_table_old)
+         RebuildStep(m_rebuild_step);
       //--- if rebuild is required
       if(m_filled==m_count)
          if(!RebuildTable(m_count<=0 ? COUNT_INITIAL : m_count * 2))
@@ -387,9 +762,9 @@ public:
       new (obj) TOther{std::forward<TArgs>(args)...};
       //--- now look for where to put
       item->hash=m_hash(*obj);
-      uint64_t idx=item->hash & m_mask;
+      HashItem **bucket=Bucket(item->hash);
       //--- check for duplicates
-      HashItem *temp=m_table[idx];
+      HashItem *temp=*bucket;
       while(temp)
         {
          if(m_equal(*(TValue*)(temp + 1), *obj))
@@ -402,8 +777,8 @@ public:
          temp=temp->next;
         }
       //--- no duplicates, insert
-      item->next=m_table[idx];
-      m_table[idx]=item;
+      item->next=*bucket;
+      *bucket=item;
       m_filled++;
       //---
       return(obj);
@@ -414,14 +789,17 @@ public:
    template <typename... TArgs>
    TValue* FindOrInsert(TArgs&&... args)
      {
-      //--- calculate the hash and index in the table
+      //--- move a part of the old table
+      if(m_table_old)
+         RebuildStep(m_rebuild_step);
+      //--- calculate the hash and bucket in the table
       const uint64_t hash=m_hash(std::forward<TArgs>(args)...);
-      uint64_t       idx=hash & m_mask;
+      HashItem     **bucket=m_count ? Bucket(hash) : nullptr;
       //--- table check
       if(m_count)
         {
          //--- find item in collision linked list
-         for(HashItem *temp=m_table[idx];temp;temp=temp->next)
+         for(HashItem *temp=*bucket;temp;temp=temp->next)
            {
             //--- check equality
             if(m_equal(*(TValue*)(temp + 1), std::forward<TArgs>(args)...))
@@ -438,8 +816,8 @@ public:
          //--- rebuild the table
          if(!RebuildTable(m_count ? m_count * 2 : COUNT_INITIAL))
             return(nullptr);
-         //--- new index in the table
-         idx=hash & m_mask;
+         //--- new bucket in the table
+         bucket=Bucket(hash);
         }
       //--- allocate
       HashItem *item=(HashItem*)m_allocator.Allocate(sizeof(HashItem) + sizeof(TValue));
@@ -452,8 +830,8 @@ public:
       new (obj) TValue{std::forward<TArgs>(args)...};
       //--- insert
       item->hash=hash;
-      item->next=m_table[idx];
-      m_table[idx]=item;
+      item->next=*bucket;
+      *bucket=item;
       m_filled++;
       return(obj);
      }
@@ -468,7 +846,7 @@ public:
       //--- calculate hash
       uint64_t hash=m_hash(std::forward<TArgs>(args)...);
       //--- now the equivalence
-      HashItem *temp=m_table[hash & m_mask];
+      HashItem *temp=*Bucket(hash);
       while(temp)
         {
          if(m_equal(*(TValue*)(temp + 1), std::forward<TArgs>(args)...))
@@ -482,6 +860,54 @@ public:
       return(nullptr);
      }
    //+------------------------------------------------------------------+
+   //| Batch search, out[i] is the element of keys[i] or nullptr        |
+   //| software pipeline: the bucket of the key is prefetched           |
+   //| 2*BATCH_DISTANCE keys ahead, the collision list head             |
+   //| BATCH_DISTANCE keys ahead, so the memory misses overlap          |
+   //+------------------------------------------------------------------+
+   template <typename TKey>
+   void FindBatch(const TKey *keys, const size_t total, TValue **out) const
+     {
+      HashItem **buckets[BATCH_SIZE];
+      //--- check
+      if(!keys || !out)
+         return;
+      //--- empty table
+      if(m_count<=0)
+        {
+         for(size_t idx=0; idx < total; idx++)
+            out[idx]=nullptr;
+         return;
+        }
+      //--- pipeline
+      for(size_t idx=0; idx < total + BATCH_DISTANCE*2; idx++)
+        {
+         //--- calculate hash and prefetch bucket
+         if(idx < total)
+           {
+            buckets[idx % BATCH_SIZE]=Bucket(m_hash(keys[idx]));
+            PreFetchCacheLine(PF_TEMPORAL_LEVEL_1, buckets[idx % BATCH_SIZE]);
+           }
+         //--- prefetch the first item of the collision list
+         if(idx >= BATCH_DISTANCE && idx - BATCH_DISTANCE < total)
+            if(HashItem *head=*buckets[(idx - BATCH_DISTANCE) % BATCH_SIZE])
+               PreFetchCacheLine(PF_TEMPORAL_LEVEL_1, head);
+         //--- now the equivalence
+         if(idx >= BATCH_DISTANCE*2)
+           {
+            const size_t pos  =idx - BATCH_DISTANCE*2;
+            TValue      *value=nullptr;
+            for(HashItem *temp=*buckets[pos % BATCH_SIZE]; temp; temp=temp->next)
+               if(m_equal(*(TValue*)(temp + 1), keys[pos]))
+                 {
+                  value=(TValue*)(temp + 1);
+                  break;
+                 }
+            out[pos]=value;
+           }
+        }
+     }
+   //+------------------------------------------------------------------+
    //| Delete the 1st and only the 1st element                          |
    //+------------------------------------------------------------------+
    template <typename... TArgs>
@@ -489,10 +915,13 @@ public:
      {
       if(m_count<=0)
          return(false);
+      //--- move a part of the old table
+      if(m_table_old)
+         RebuildStep(m_rebuild_step);
       //--- calculate hash
       uint64_t hash=m_hash(std::forward<TArgs>(args)...);
       //--- now the equivalence
-      HashItem **temp=&m_table[hash & m_mask];
+      HashItem **temp=Bucket(hash);
       while(*temp)
         {
          if(m_equal(*(TValue*)(*temp + 1), std::forward<TArgs>(args)...))
@@ -529,6 +958,8 @@ public:
    //+------------------------------------------------------------------+
    void Shutdown(void)
      {
+      //--- the old table items are released with the new ones
+      RebuildComplete();
       //--- free memory
       if(m_table)
         {
@@ -561,8 +992,26 @@ public:
    template <typename TIterator, typename... TArgs>
    void Iterate(TIterator &&iterator, TArgs&&... args)
      {
+      //--- not yet moved buckets of the old table first
+      for(uint64_t tt=m_rebuild_pos; tt < m_count_old; tt++)
+        {
+         HashItem *temp=m_table_old[tt];
+         while(temp)
+           {
+            HashItem* next=temp->next;
+            //--- pass the call to the functor with additional parameters
+            if(!iterator(*(TValue*)(temp + 1), std::forward<TArgs>(args)...))
+               return;
+            //--- to the next
+            temp=next;
+           }
+        }
+      //--- new table
       for(uint64_t tt=0; tt < m_count; tt++)
         {
+         //--- skip not yet initialized buckets
+         if(m_table_old && (tt & m_mask_old)>=m_rebuild_pos)
+            continue;
          HashItem *temp=m_table[tt];
          while(temp)
            {
@@ -585,8 +1034,8 @@ public:
    //+------------------------------------------------------------------+
    //| Iteration                                                        |
    //+------------------------------------------------------------------+
-   Iterator          begin(void)             { return{m_table,m_count}; }
-   ConstIterator     begin(void) const       { return{m_table,m_count}; }
+   Iterator          begin(void)             { return(m_table_old ? Iterator{m_table,m_count,m_table_old,m_count_old,m_rebuild_pos} : Iterator{m_table,m_count});                }
+   ConstIterator     begin(void) const       { return(m_table_old ? ConstIterator{m_table,m_count,m_table_old,m_count_old,m_rebuild_pos} : ConstIterator{m_table,m_count}); }
    constexpr Iterator end(void)              { return{}; }
    constexpr ConstIterator end(void) const   { return{}; }
 
@@ -601,14 +1050,31 @@ private:
      {
       if(new_count<=m_count)
          return(false);
+      //--- only one rebuild at a time
+      RebuildComplete();
       //--- allocate memory for the new table
       HashItem **new_table=(HashItem**)m_allocator.Allocate(sizeof(HashItem*) * new_count);
       if(new_table==nullptr)
          return(false);
-      //--- be sure to clean up
-      ZeroMemory(new_table, sizeof(HashItem*) * new_count);
 
       uint64_t new_mask=new_count - 1;
+      //--- incremental mode, keep the old table and move it step by step,
+      //--- the new table buckets are cleaned up as the old buckets are moved
+      if(m_rebuild_step && m_filled)
+        {
+         m_table_old  =m_table;
+         m_count_old  =m_count;
+         m_mask_old   =m_mask;
+         m_rebuild_pos=0;
+         //--- swap tables
+         m_table=new_table;
+         m_mask =new_mask;
+         m_count=new_count;
+         //---
+         return(true);
+        }
+      //--- be sure to clean up
+      ZeroMemory(new_table, sizeof(HashItem*) * new_count);
       //--- if there is something to copy
       if(m_table)
         {
@@ -638,5 +1104,51 @@ private:
       //---
       return(true);
      }
+   //+------------------------------------------------------------------+
+   //| Bucket of the hash, during incremental rebuild the not yet       |
+   //| moved items are in the old table                                 |
+   //+------------------------------------------------------------------+
+   HashItem** Bucket(const uint64_t hash) const
+     {
+      if(m_table_old && (hash & m_mask_old)>=m_rebuild_pos)
+         return(&m_table_old[hash & m_mask_old]);
+      return(&m_table[hash & m_mask]);
+     }
+   //+------------------------------------------------------------------+
+   //| Move buckets of the old table to the new one                     |
+   //+------------------------------------------------------------------+
+   void RebuildStep(uint64_t buckets)
+     {
+      //--- move bucket by bucket
+      for(; buckets>0 && m_rebuild_pos<m_count_old; buckets--, m_rebuild_pos++)
+        {
+         //--- clean up new buckets corresponding to the old one
+         for(uint64_t idx=m_rebuild_pos; idx < m_count; idx+=m_count_old)
+            m_table[idx]=nullptr;
+         //--- now move the collision list
+         HashItem* temp=m_table_old[m_rebuild_pos];
+         while(temp)
+           {
+            //--- save the next
+            HashItem* next=temp->next;
+            //--- insert into the new table
+            uint64_t idx=temp->hash & m_mask;
+            temp->next=m_table[idx];
+            m_table[idx]=temp;
+            //--- to the next
+            temp=next;
+           }
+         m_table_old[m_rebuild_pos]=nullptr;
+        }
+      //--- release old
+      if(m_rebuild_pos>=m_count_old)
+        {
+         m_allocator.Free(m_table_old);
+         m_table_old  =nullptr;
+         m_count_old  =0;
+         m_mask_old   =0;
+         m_rebuild_pos=0;
+        }
+     }
   };
 //+------------------------------------------------------------------+
@@ -0,0 +1,1142 @@
+//+------------------------------------------------------------------+
+//|                                                 MetaTrader 5 API |
+//|                             Copyright 2000-2025, MetaQuotes Ltd. |
+//|                                               www.metaquotes.net |
+//+------------------------------------------------------------------+
+#pragma once
+#include <new.h>
+#include <string.h>
+#include "MT5APIStorage.h"
+//---
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define MTAPI_LOGINSET_SSE2
+#include <emmintrin.h>
+#if defined(__AVX2__)
+#define MTAPI_LOGINSET_AVX2
+#include <immintrin.h>
+#endif
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+//+------------------------------------------------------------------+
+//| Compressed set of logins                                         |
+//| logins are split by the high 48 bits into containers of 65536    |
+//| values, a container is a sorted array up to 4096 values, a       |
+//| bitmap of 65536 bits or a list of runs after Optimize            |
+//| set operations give array and bitmap containers, bitmaps are     |
+//| combined by SIMD words operations, the class is not thread safe  |
+//+------------------------------------------------------------------+
+class CMTLoginSet
+  {
+public:
+   //--- constants
+   enum constants
+     {
+      ARRAY_MAX        =4096,             // maximum values of array container
+      BITMAP_WORDS     =1024,             // words of bitmap container
+     };
+
+private:
+   //--- container types
+   enum EnContainerType
+     {
+      CONTAINER_ARRAY  =0,                // sorted values
+      CONTAINER_BITMAP =1,                // bitmap
+      CONTAINER_RUN    =2,                // pairs of run start and length-1
+     };
+   //--- container of logins with the same high 48 bits
+   struct Container
+     {
+      uint64_t          key;              // high 48 bits of logins
+      uint32_t          type;             // EnContainerType
+      uint32_t          cardinality;      // logins total
+      uint32_t          size;             // values or runs total
+      uint32_t          max;              // allocated values or runs
+      uint16_t         *values;           // values or runs
+      uint64_t         *bits;             // bitmap
+     };
+   typedef TMTArray<Container,16,MTArrayGrowGeometric> ContainerArray;
+
+private:
+   ContainerArray    m_containers;        // containers sorted by key
+   uint64_t          m_total;             // logins total
+   uint32_t          m_last;              // last used container for sequential Add
+
+public:
+                     CMTLoginSet(void) : m_total(0),m_last(0) {}
+                    ~CMTLoginSet(void)    { Shutdown(); }
+   //--- properties
+   uint64_t          Total(void) const    { return(m_total); }
+   //--- global management
+   void              Clear(void);
+   void              Shutdown(void);
+   bool              Assign(const CMTLoginSet &set);
+   bool              Optimize(void);
+   //--- add, remove and check
+   bool              Add(const uint64_t login);
+   bool              Add(const uint64_t *logins,const uint32_t total);
+   bool              Add(const MTUInt64Array &logins)     { return(Add(logins.begin(),logins.Total())); }
+   bool              Remove(const uint64_t login);
+   bool              Contains(const uint64_t login) const;
+   //--- set operations in place
+   bool              Union(const CMTLoginSet &set);
+   bool              Intersect(const CMTLoginSet &set);
+   bool              AndNot(const CMTLoginSet &set);
+   //--- iterate logins in ascending order, the functor returns false to stop
+   template <typename TIterator>
+   bool              Iterate(TIterator &&iterator) const;
+   bool              ToArray(MTUInt64Array &logins) const;
+
+private:
+   //--- prohibit copy constructor and assignment
+                     CMTLoginSet(const CMTLoginSet&);
+   CMTLoginSet&      operator=(const CMTLoginSet&);
+   //--- containers search
+   uint32_t          Find(const uint64_t key,bool &found) const;
+   void              TotalUpdate(void);
+   //--- single container
+   static bool       ContainerCreate(Container &container,const uint64_t key);
+   static void       ContainerFree(Container &container);
+   static bool       ContainerCopy(Container &dst,const Container &src);
+   static bool       ContainerContains(const Container &container,const uint16_t value);
+   static bool       ContainerAdd(Container &container,const uint16_t value);
+   static bool       ContainerRemove(Container &container,const uint16_t value);
+   template <typename TIterator>
+   static bool       ContainerIterate(const Container &container,TIterator &&iterator);
+   //--- container conversions
+   static bool       ContainerToBitmap(Container &container);
+   static bool       ContainerToArray(Container &container);
+   static bool       ContainerExpand(Container &container);
+   static bool       ContainerOptimize(Container &container);
+   //--- containers operations
+   static bool       ContainerUnion(Container &dst,const Container &src);
+   static bool       ContainerIntersect(Container &dst,const Container &src);
+   static bool       ContainerAndNot(Container &dst,const Container &src);
+   //--- arrays and runs
+   static uint32_t   ArraySearch(const uint16_t *values,const uint32_t total,const uint16_t value);
+   static bool       ArrayGrow(Container &container);
+   static uint32_t   RunSearch(const uint16_t *runs,const uint32_t total,const uint16_t value);
+   //--- bitmaps
+   static void       BitmapSetRange(uint64_t *bits,const uint32_t first,const uint32_t last);
+   static void       BitmapClearRange(uint64_t *bits,const uint32_t first,const uint32_t last);
+   static void       BitmapFromRuns(uint64_t *bits,const Container &container);
+   static uint32_t   BitmapOr(uint64_t *dst,const uint64_t *src);
+   static uint32_t   BitmapAnd(uint64_t *dst,const uint64_t *src);
+   static uint32_t   BitmapAndNot(uint64_t *dst,const uint64_t *src);
+   static uint32_t   BitmapCount(const uint64_t *bits);
+   static uint32_t   BitmapRuns(const uint64_t *bits);
+   static uint32_t   BitCount(const uint64_t value);
+   static uint32_t   LowestBit(const uint64_t value);
+  };
+//+------------------------------------------------------------------+
+//| Remove all logins                                                |
+//+------------------------------------------------------------------+
+inline void CMTLoginSet::Clear(void)
+  {
+   for(uint32_t i=0; i<m_containers.Total(); i++)
+      ContainerFree(m_containers[i]);
+   m_containers.Clear();
+   m_total=0;
+   m_last =0;
+  }
+//+------------------------------------------------------------------+
+//| Remove all logins and free memory                                |
+//+------------------------------------------------------------------+
+inline void CMTLoginSet::Shutdown(void)
+  {
+   Clear();
+   m_containers.Shutdown();
+  }
+//+------------------------------------------------------------------+
+//| Copy set                                                         |
+//+------------------------------------------------------------------+
+inline bool CMTLoginSet::Assign(const CMTLoginSet &set)
+  {
+//--- check
+   if(this==&set)
+      return(true);
+//--- copy containers
+   Clear();
+   if(!m_containers.Reserve(set.m_containers.Total()))
+      return(false);
+   for(uint32_t i=0; i<set.m_containers.Total(); i++)
+     {
+      Container container;
+      if(!ContainerCopy(container,set.m_containers[i]))
+        {
+         Clear();
+         return(false);
+        }
+      m_containers.Add(&container);
+     }
+   m_total=set.m_total;
+   return(true);
+  }
+//+------------------------------------------------------------------+
+//| Convert containers to the smallest form, runs are used for       |
+//| dense login ranges                                               |
+//+------------------------------------------------------------------+
+inline bool CMTLoginSet::Optimize(void)
+  {
+   bool res=true;
+   for(uint32_t i=0; i<m_containers.Total(); i++)
+      res=ContainerOptimize(m_containers[i]) && res;
+   return(res);
+  }
+//+------------------------------------------------------------------+
+//| Add login, false on memory error                                 |
+//+------------------------------------------------------------------+
+inline bool CMTLoginSet::Add(const uint64_t login)
+  {
+   const uint64_t key=login>>16;
+   uint32_t       pos=m_last;
+   bool           found=false;
+//--- sorted logins go to the last or to the next container
+   if(pos<m_containers.Total() && m_containers[pos].key==key)
+      found=true;
+   else
+      if(pos+1<m_containers.Total() && m_containers[pos+1].key==key)
+        {
+         pos++;
+         found=true;
+        }
+      else
+         pos=Find(key,found);
+//--- create container
+   if(!found)
+     {
+      Container container;
+      if(!ContainerCreate(container,key))
+         return(false);
+      if(!m_containers.Insert(pos,&container))
+        {
+         ContainerFree(container);
+         return(false);
+        }
+     }
+   m_last=pos;
+//--- add value
+   Container     &container=m_containers[pos];
+   const uint32_t cardinality=container.cardinality;
+   if(!ContainerAdd(container,uint16_t(login)))
+     {
+      if(!container.cardinality)
+        {
+         ContainerFree(container);
+         m_containers.Delete(pos);
+        }
+      return(false);
+     }
+   m_total+=container.cardinality-cardinality;
+   return(true);
+  }
+//+------------------------------------------------------------------+
+//| Add logins, sorted logins are added faster                       |
+//+------------------------------------------------------------------+
+inline bool CMTLoginSet::Add(const uint64_t *logins,const uint32_t total)
+  {
+//--- check
+   if(!logins && total)
+      return(false);
+//--- add
+   for(uint32_t i=0; i<total; i++)
+      if(!Add(logins[i]))
+         return(false);
+   return(true);
+  }
+//+------------------------------------------------------------------+
+//| Remove login, false if there is no login                         |
+//+------------------------------------------------------------------+
+inline bool CMTLoginSet::Remove(const uint64_t login)
+  {
+   bool found=false;
+//--- search container
+   const uint32_t pos=Find(login>>16,found);
+   if(!found)
+      return(false);
+//--- remove value
+   Container &container=m_containers[pos];
+   if(!ContainerRemove(container,uint16_t(login)))
+      return(false);
+   m_total--;
+//--- remove empty container
+   if(!container.cardinality)
+     {
+      ContainerFree(container);
+      m_containers.Delete(pos);
+      m_last=0;
+     }
+   return(true);
+  }
+//+------------------------------------------------------------------+
+//| Check login                                                      |
+//+------------------------------------------------------------------+
+inline bool CMTLoginSet::Contains(const uint64_t login) const
+  {
+   bool found=false;
+   const uint32_t pos=Find(login>>16,found);
+   return(found && ContainerContains(m_containers[pos],uint16_t(login)));
+  }
+//+------------------------------------------------------------------+
+//| Add logins of set                                                |
+//| on memory error the set contains a part of the union             |
+//+------------------------------------------------------------------+
+inline bool CMTLoginSet::Union(const CMTLoginSet &set)
+  {
+   ContainerArray containers;
+   uint32_t       i=0,j=0;
+   bool           res=true;
+//--- check
+   if(this==&set || !set.m_containers.Total())
+      return(true);
+   if(!containers.Reserve(m_containers.Total()+set.m_containers.Total()))
+      return(false);
+//--- merge containers by keys
+   while(i<m_containers.Total() || j<set.m_containers.Total())
+     {
+      //--- own container
+      if(j>=set.m_containers.Total() || (i<m_containers.Total() && m_containers[i].key<set.m_containers[j].key))
+        {
+         containers.Add(&m_containers[i++]);
+         continue;
+        }
+      //--- the other container is copied
+      if(!res)
+        {
+         j++;
+         continue;
+        }
+      if(i>=m_containers.Total() || set.m_containers[j].key<m_containers[i].key)
+        {
+         Container container;
+         if(ContainerCopy(container,set.m_containers[j]))
+            containers.Add(&container);
+         else
+            res=false;
+         j++;
+         continue;
+        }
+      //--- the same keys
+      res=ContainerUnion(m_containers[i],set.m_containers[j]);
+      containers.Add(&m_containers[i]);
+      i++;
+      j++;
+     }
+//--- replace containers
+   m_containers.Swap(containers);
+   TotalUpdate();
+   return(res);
+  }
+//+------------------------------------------------------------------+
+//| Keep logins present in set                                       |
+//+------------------------------------------------------------------+
+inline bool CMTLoginSet::Intersect(const CMTLoginSet &set)
+  {
+   uint32_t count=0,j=0;
+   bool     res=true;
+//--- check
+   if(this==&set)
+      return(true);
+//--- keep containers with the same keys
+   for(uint32_t i=0; i<m_containers.Total(); i++)
+     {
+      Container &container=m_containers[i];
+      while(j<set.m_containers.Total() && set.m_containers[j].key<container.key)
+         j++;
+      //--- the other set has no such container
+      if(j>=set.m_containers.Total() || set.m_containers[j].key!=container.key)
+        {
+         ContainerFree(container);
+         continue;
+        }
+      //--- intersect, container stays unchanged on error
+      if(!ContainerIntersect(container,set.m_containers[j]))
+         res=false;
+      if(container.cardinality)
+         m_containers[count++]=container;
+      else
+         ContainerFree(container);
+     }
+//--- cut array
+   if(count)
+      m_containers.Resize(count);
+   else
+      m_containers.Clear();
+   TotalUpdate();
+   return(res);
+  }
+//+------------------------------------------------------------------+
+//| Remove logins present in set                                     |
+//+------------------------------------------------------------------+
+inline bool CMTLoginSet::AndNot(const CMTLoginSet &set)
+  {
+   uint32_t count=0,j=0;
+   bool     res=true;
+//--- check
+   if(this==&set)
+     {
+      Clear();
+      return(true);
+     }
+//--- change containers with the same keys
+   for(uint32_t i=0; i<m_containers.Total(); i++)
+     {
+      Container &container=m_containers[i];
+      while(j<set.m_containers.Total() && set.m_containers[j].key<container.key)
+         j++;
+      if(j<set.m_containers.Total() && set.m_containers[j].key==container.key)
+         if(!ContainerAndNot(container,set.m_containers[j]))
+            res=false;
+      if(container.cardinality)
+         m_containers[count++]=container;
+      else
+         ContainerFree(container);
+     }
+//--- cut array
+   if(count)
+      m_containers.Resize(count);
+   else
+      m_containers.Clear();
+   TotalUpdate();
+   return(res);
+  }
+//+------------------------------------------------------------------+
+//| Iterate logins in ascending order                                |
+//| false if the functor has stopped iteration                       |
+//+------------------------------------------------------------------+
+template <typename TIterator>
+inline bool CMTLoginSet::Iterate(TIterator &&iterator) const
+  {
+   for(uint32_t i=0; i<m_containers.Total(); i++)
+     {
+      const uint64_t base=m_containers[i].key<<16;
+      if(!ContainerIterate(m_containers[i],[&iterator,base](const uint16_t value) { return(iterator(base|value)); }))
+         return(false);
+     }
+   return(true);
+  }
+//+------------------------------------------------------------------+
+//| Export logins to sorted array                                    |
+//+------------------------------------------------------------------+
+inline bool CMTLoginSet::ToArray(MTUInt64Array &logins) const
+  {
+//--- check
+   logins.Clear();
+   if(m_total>0xFFFFFFFF || !logins.Reserve(uint32_t(m_total)))
+      return(false);
+//--- fill
+   Iterate([&logins](const uint64_t login) { return(logins.Add(&login)); });
+   return(true);
+  }
+//+------------------------------------------------------------------+
+//| Search container position by key, insert position if not found   |
+//+------------------------------------------------------------------+
+inline uint32_t CMTLoginSet::Find(const uint64_t key,bool &found) const
+  {
+   const Container *containers=m_containers.begin();
+   uint32_t         left=0,right=m_containers.Total();
+//--- binary search
+   while(left<right)
+     {
+      const uint32_t middle=(left+right)/2;
+      if(containers[middle].key<key)
+         left=middle+1;
+      else
+         right=middle;
+     }
+   found=(left<m_containers.Total() && containers[left].key==key);
+   return(left);
+  }
+//+------------------------------------------------------------------+
+//| Recalculate logins total                                         |
+//+------------------------------------------------------------------+
+inline void CMTLoginSet::TotalUpdate(void)
+  {
+   m_total=0;
+   for(uint32_t i=0; i<m_containers.Total(); i++)
+      m_total+=m_containers[i].cardinality;
+   m_last=0;
+  }
+//+------------------------------------------------------------------+
+//| Create empty array container                                     |
+//+------------------------------------------------------------------+
+inline bool CMTLoginSet::ContainerCreate(Container &container,const uint64_t key)
+  {
+   ZeroMemory(&container,sizeof(container));
+   container.key =key;
+   container.type=CONTAINER_ARRAY;
+   container.max =4;
+   return((container.values=new(std::nothrow) uint16_t[container.max])!=NULL);
+  }
+//+------------------------------------------------------------------+
+//| Free container memory                                            |
+//+------------------------------------------------------------------+
+inline void CMTLoginSet::ContainerFree(Container &container)
+  {
+   if(container.values)
+     {
+      delete[] container.values;
+      container.values=NULL;
+     }
+   if(container.bits)
+     {
+      delete[] container.bits;
+      container.bits=NULL;
+     }
+   container.cardinality=container.size=container.max=0;
+  }
+//+------------------------------------------------------------------+
+//| Copy container                                                   |
+//+------------------------------------------------------------------+
+inline bool CMTLoginSet::ContainerCopy(Container &dst,const Container &src)
+  {
+   dst=src;
+//--- bitmap
+   if(src.type==CONTAINER_BITMAP)
+     {
+      if((dst.bits=new(std::nothrow) uint64_t[BITMAP_WORDS])==NULL)
+         return(false);
+      memcpy(dst.bits,src.bits,BITMAP_WORDS*sizeof(uint64_t));
+      return(true);
+     }
+//--- values or runs
+   const uint32_t count=src.type==CONTAINER_RUN ? src.size*2 : src.size;
+   dst.max=src.size ? src.size : 1;
+   if((dst.values=new(std::nothrow) uint16_t[src.type==CONTAINER_RUN ? dst.max*2 : dst.max])==NULL)
+      return(false);
+   memcpy(dst.values,src.values,count*sizeof(uint16_t));
+   return(true);
+  }
+//+------------------------------------------------------------------+
+//| Check value                                                      |
+//+------------------------------------------------------------------+
+inline bool CMTLoginSet::ContainerContains(const Container &container,const uint16_t value)
+  {
+   switch(container.type)
+     {
+      case CONTAINER_BITMAP:
+         return((container.bits[value>>6]>>(value&63))&1);
+      case CONTAINER_ARRAY:
+        {
+         const uint32_t pos=ArraySearch(container.values,container.size,value);
+         return(pos<container.size && container.values[pos]==value);
+        }
+      case CONTAINER_RUN:
+        {
+         const uint32_t pos=RunSearch(container.values,container.size,value);
+         return(pos<container.size && uint32_t(value-container.values[pos*2])<=container.values[pos*2+1]);
+        }
+     }
+   return(false);
+  }
+//+------------------------------------------------------------------+
+//| Add value, false on memory error                                 |
+//+------------------------------------------------------------------+
+inline bool CMTLoginSet::ContainerAdd(Container &container,const uint16_t value)
+  {
+//--- runs are expanded for changing
+   if(container.type==CONTAINER_RUN)
+     {
+      if(ContainerContains(container,value))
+         return(true);
+      if(!ContainerExpand(container))
+         return(false);
+     }
+//--- array
+   if(container.type==CONTAINER_ARRAY)
+     {
+      const uint32_t pos=ArraySearch(container.values,container.size,value);
+      if(pos<container.size && container.values[pos]==value)
+         return(true);
+      //--- full array becomes bitmap
+      if(container.size<ARRAY_MAX)
+        {
+         if(container.size>=container.max && !ArrayGrow(container))
+            return(false);
+         memmove(container.values+pos+1,container.values+pos,(container.size-pos)*sizeof(uint16_t));
+         container.values[pos]=value;
+         container.size++;
+         container.cardinality++;
+         return(true);
+        }
+      if(!ContainerToBitmap(container))
+         return(false);
+     }
+//--- bitmap
+   uint64_t &word=container.bits[value>>6];
+   const uint64_t mask=uint64_t(1)<<(value&63);
+   if(!(word & mask))
+     {
+      word|=mask;
+      container.cardinality++;
+     }
+   return(true);
+  }
+//+------------------------------------------------------------------+
+//| Remove value, false if there is no value                         |
+//+------------------------------------------------------------------+
+inline bool CMTLoginSet::ContainerRemove(Container &container,const uint16_t value)
+  {
+//--- check
+   if(!ContainerContains(container,value))
+      return(false);
+//--- runs are expanded for changing, container stays valid on error
+   if(container.type==CONTAINER_RUN && !ContainerExpand(container))
+      return(false);
+//--- array
+   if(container.type==CONTAINER_ARRAY)
+     {
+      const uint32_t pos=ArraySearch(container.values,container.size,value);
+      memmove(container.values+pos,container.values+pos+1,(container.size-pos-1)*sizeof(uint16_t));
+      container.size--;
+      container.cardinality--;
+      return(true);
+     }
+//--- bitmap, sparse bitmap becomes array, half of maximum avoids conversions back and forth
+   container.bits[value>>6]&=~(uint64_t(1)<<(value&63));
+   container.cardinality--;
+   if(container.cardinality<=ARRAY_MAX/2)
+      ContainerToArray(container);
+   return(true);
+  }
+//+------------------------------------------------------------------+
+//| Iterate container values in ascending order                      |
+//+------------------------------------------------------------------+
+template <typename TIterator>
+inline bool CMTLoginSet::ContainerIterate(const Container &container,TIterator &&iterator)
+  {
+   switch(container.type)
+     {
+      case CONTAINER_ARRAY:
+         for(uint32_t i=0; i<container.size; i++)
+            if(!iterator(container.values[i]))
+               return(false);
+         break;
+      case CONTAINER_BITMAP:
+         for(uint32_t i=0; i<BITMAP_WORDS; i++)
+            for(uint64_t word=container.bits[i]; word; word&=word-1)
+               if(!iterator(uint16_t(i*64+LowestBit(word))))
+                  return(false);
+         break;
+      case CONTAINER_RUN:
+         for(uint32_t i=0; i<container.size; i++)
+            for(uint32_t value=container.values[i*2],last=value+container.values[i*2+1]; value<=last; value++)
+               if(!iterator(uint16_t(value)))
+                  return(false);
+         break;
+     }
+   return(true);
+  }
+//+------------------------------------------------------------------+
+//| Convert array or runs to bitmap                                  |
+//+------------------------------------------------------------------+
+inline bool CMTLoginSet::ContainerToBitmap(Container &container)
+  {
+//--- check
+   if(container.type==CONTAINER_BITMAP)
+      return(true);
+//--- fill bitmap
+   uint64_t *bits=new(std::nothrow) uint64_t[BITMAP_WORDS];
+   if(!bits)
+      return(false);
+   ZeroMemory(bits,BITMAP_WORDS*sizeof(uint64_t));
+   if(container.type==CONTAINER_RUN)
+      BitmapFromRuns(bits,container);
+   else
+      for(uint32_t i=0; i<container.size; i++)
+         bits[container.values[i]>>6]|=uint64_t(1)<<(container.values[i]&63);
+//--- replace
+   delete[] container.values;
+   container.values=NULL;
+   container.bits  =bits;
+   container.type  =CONTAINER_BITMAP;
+   container.size  =container.max=0;
+   return(true);
+  }
+//+------------------------------------------------------------------+
+//| Convert bitmap or runs to array, container must fit to array     |
+//+------------------------------------------------------------------+
+inline bool CMTLoginSet::ContainerToArray(Container &container)
+  {
+//--- check
+   if(container.type==CONTAINER_ARRAY)
+      return(true);
+   if(container.cardinality>ARRAY_MAX)
+      return(false);
+//--- fill array
+   const uint32_t max=container.cardinality ? container.cardinality : 1;
+   uint16_t      *values=new(std::nothrow) uint16_t[max];
+   uint32_t       count=0;
+   if(!values)
+      return(false);
+   ContainerIterate(container,[values,&count](const uint16_t value) { values[count++]=value; return(true); });
+//--- replace
+   ContainerFree(container);
+   container.values     =values;
+   container.type       =CONTAINER_ARRAY;
+   container.cardinality=container.size=count;
+   container.max        =max;
+   return(true);
+  }
+//+------------------------------------------------------------------+
+//| Convert runs to array or bitmap for changing                     |
+//+------------------------------------------------------------------+
+inline bool CMTLoginSet::ContainerExpand(Container &container)
+  {
+   if(container.type!=CONTAINER_RUN)
+      return(true);
+   if(container.cardinality<=ARRAY_MAX)
+      return(ContainerToArray(container));
+   return(ContainerToBitmap(container));
+  }
+//+------------------------------------------------------------------+
+//| Convert container to the smallest form                           |
+//+------------------------------------------------------------------+
+inline bool CMTLoginSet::ContainerOptimize(Container &container)
+  {
+   uint32_t runs=0;
+//--- count runs
+   switch(container.type)
+     {
+      case CONTAINER_ARRAY:
+         for(uint32_t i=0; i<container.size; i++)
+            if(!i || container.values[i]!=container.values[i-1]+1)
+               runs++;
+         break;
+      case CONTAINER_BITMAP:
+         runs=BitmapRuns(container.bits);
+         break;
+      case CONTAINER_RUN:
+         runs=container.size;
+         break;
+     }
+//--- sizes in bytes
+   const uint32_t size_runs =runs*2*sizeof(uint16_t);
+   const uint32_t size_other=container.cardinality<=ARRAY_MAX ? container.cardinality*uint32_t(sizeof(uint16_t)) : BITMAP_WORDS*uint32_t(sizeof(uint64_t));
+//--- array or bitmap is smaller
+   if(size_other<=size_runs)
+     {
+      if(container.type==CONTAINER_RUN)
+         return(ContainerExpand(container));
+      if(container.type==CONTAINER_BITMAP)
+         return(container.cardinality>ARRAY_MAX || ContainerToArray(container));
+      //--- shrink array buffer
+      if(container.type==CONTAINER_ARRAY && container.max>container.size)
+        {
+         uint16_t *values=new(std::nothrow) uint16_t[container.size];
+         if(!values)
+            return(false);
+         memcpy(values,container.values,container.size*sizeof(uint16_t));
+         delete[] container.values;
+         container.values=values;
+         container.max   =container.size;
+        }
+      return(true);
+     }
+//--- runs are smaller
+   if(container.type==CONTAINER_RUN)
+      return(true);
+   uint16_t *values=new(std::nothrow) uint16_t[runs*2];
+   uint32_t  count=0;
+   if(!values)
+      return(false);
+   ContainerIterate(container,[values,&count](const uint16_t value)
+     {
+      if(count && uint32_t(values[count*2-2])+values[count*2-1]+1==value)
+         values[count*2-1]++;
+      else
+        {
+         values[count*2]  =value;
+         values[count*2+1]=0;
+         count++;
+        }
+      return(true);
+     });
+//--- replace
+   const uint32_t cardinality=container.cardinality;
+   ContainerFree(container);
+   container.values     =values;
+   container.type       =CONTAINER_RUN;
+   container.cardinality=cardinality;
+   container.size       =container.max=count;
+   return(true);
+  }
+//+------------------------------------------------------------------+
+//| Add values of src to dst                                         |
+//| dst stays unchanged on memory error                              |
+//+------------------------------------------------------------------+
+inline bool CMTLoginSet::ContainerUnion(Container &dst,const Container &src)
+  {
+//--- small arrays are merged
+   if(dst.type==CONTAINER_ARRAY && src.type==CONTAINER_ARRAY && dst.size+src.size<=ARRAY_MAX)
+     {
+      const uint32_t max=dst.size+src.size;
+      uint16_t      *values=new(std::nothrow) uint16_t[max ? max : 1];
+      uint32_t       i=0,j=0,count=0;
+      if(!values)
+         return(false);
+      while(i<dst.size && j<src.size)
+        {
+         const uint16_t a=dst.values[i],b=src.values[j];
+         values[count++]=a<b ? a : b;
+         i+=(a<=b);
+         j+=(b<=a);
+        }
+      while(i<dst.size) values[count++]=dst.values[i++];
+      while(j<src.size) values[count++]=src.values[j++];
+      //--- replace
+      delete[] dst.values;
+      dst.values     =values;
+      dst.cardinality=dst.size=count;
+      dst.max        =max ? max : 1;
+      return(true);
+     }
+//--- other containers through bitmap
+   if(!ContainerToBitmap(dst))
+      return(false);
+   switch(src.type)
+     {
+      case CONTAINER_ARRAY:
+         for(uint32_t i=0; i<src.size; i++)
+            dst.bits[src.values[i]>>6]|=uint64_t(1)<<(src.values[i]&63);
+         dst.cardinality=BitmapCount(dst.bits);
+         break;
+      case CONTAINER_BITMAP:
+         dst.cardinality=BitmapOr(dst.bits,src.bits);
+         break;
+      case CONTAINER_RUN:
+         BitmapFromRuns(dst.bits,src);
+         dst.cardinality=BitmapCount(dst.bits);
+         break;
+     }
+//--- sparse result
+   if(dst.cardinality<=ARRAY_MAX)
+      ContainerToArray(dst);
+   return(true);
+  }
+//+------------------------------------------------------------------+
+//| Keep values of dst present in src                                |
+//| dst stays unchanged on memory error                              |
+//+------------------------------------------------------------------+
+inline bool CMTLoginSet::ContainerIntersect(Container &dst,const Container &src)
+  {
+   uint32_t count=0;
+//--- array is filtered in place
+   if(dst.type==CONTAINER_ARRAY)
+     {
+      if(src.type==CONTAINER_ARRAY)
+        {
+         for(uint32_t i=0,j=0; i<dst.size && j<src.size;)
+           {
+            const uint16_t a=dst.values[i],b=src.values[j];
+            if(a==b)
+               dst.values[count++]=a;
+            i+=(a<=b);
+            j+=(b<=a);
+           }
+        }
+      else
+        {
+         for(uint32_t i=0; i<dst.size; i++)
+            if(ContainerContains(src,dst.values[i]))
+               dst.values[count++]=dst.values[i];
+        }
+      dst.cardinality=dst.size=count;
+      return(true);
+     }
+//--- array of src filtered by dst is the result
+   if(src.type==CONTAINER_ARRAY)
+     {
+      uint16_t *values=new(std::nothrow) uint16_t[src.size ? src.size : 1];
+      if(!values)
+         return(false);
+      for(uint32_t i=0; i<src.size; i++)
+         if(ContainerContains(dst,src.values[i]))
+            values[count++]=src.values[i];
+      //--- replace
+      ContainerFree(dst);
+      dst.values     =values;
+      dst.type       =CONTAINER_ARRAY;
+      dst.cardinality=dst.size=count;
+      dst.max        =src.size ? src.size : 1;
+      return(true);
+     }
+//--- bitmaps
+   if(!ContainerToBitmap(dst))
+      return(false);
+   if(src.type==CONTAINER_BITMAP)
+      dst.cardinality=BitmapAnd(dst.bits,src.bits);
+   else
+     {
+      uint64_t bits[BITMAP_WORDS]={};
+      BitmapFromRuns(bits,src);
+      dst.cardinality=BitmapAnd(dst.bits,bits);
+     }
+//--- sparse result
+   if(dst.cardinality<=ARRAY_MAX)
+      ContainerToArray(dst);
+   return(true);
+  }
+//+------------------------------------------------------------------+
+//| Remove values of dst present in src                              |
+//| dst stays unchanged on memory error                              |
+//+------------------------------------------------------------------+
+inline bool CMTLoginSet::ContainerAndNot(Container &dst,const Container &src)
+  {
+   uint32_t count=0;
+//--- array is filtered in place
+   if(dst.type==CONTAINER_ARRAY)
+     {
+      if(src.type==CONTAINER_ARRAY)
+        {
+         uint32_t j=0;
+         for(uint32_t i=0; i<dst.size; i++)
+           {
+            while(j<src.size && src.values[j]<dst.values[i])
+               j++;
+            if(j>=src.size || src.values[j]!=dst.values[i])
+               dst.values[count++]=dst.values[i];
+           }
+        }
+      else
+        {
+         for(uint32_t i=0; i<dst.size; i++)
+            if(!ContainerContains(src,dst.values[i]))
+               dst.values[count++]=dst.values[i];
+        }
+      dst.cardinality=dst.size=count;
+      return(true);
+     }
+//--- bitmaps
+   if(!ContainerToBitmap(dst))
+      return(false);
+   switch(src.type)
+     {
+      case CONTAINER_ARRAY:
+         for(uint32_t i=0; i<src.size; i++)
+            dst.bits[src.values[i]>>6]&=~(uint64_t(1)<<(src.values[i]&63));
+         dst.cardinality=BitmapCount(dst.bits);
+         break;
+      case CONTAINER_BITMAP:
+         dst.cardinality=BitmapAndNot(dst.bits,src.bits);
+         break;
+      case CONTAINER_RUN:
+         for(uint32_t i=0; i<src.size; i++)
+            BitmapClearRange(dst.bits,src.values[i*2],uint32_t(src.values[i*2])+src.values[i*2+1]);
+         dst.cardinality=BitmapCount(dst.bits);
+         break;
+     }
+//--- sparse result
+   if(dst.cardinality<=ARRAY_MAX)
+      ContainerToArray(dst);
+   return(true);
+  }
+//+------------------------------------------------------------------+
+//| Position of the first value not less than value                  |
+//+------------------------------------------------------------------+
+inline uint32_t CMTLoginSet::ArraySearch(const uint16_t *values,const uint32_t total,const uint16_t value)
+  {
+   uint32_t left=0,right=total;
+//--- binary search
+   while(left<right)
+     {
+      const uint32_t middle=(left+right)/2;
+      if(values[middle]<value)
+         left=middle+1;
+      else
+         right=middle;
+     }
+   return(left);
+  }
+//+------------------------------------------------------------------+
+//| Grow array buffer twice up to the maximum                        |
+//+------------------------------------------------------------------+
+inline bool CMTLoginSet::ArrayGrow(Container &container)
+  {
+   const uint32_t max=container.max*2<ARRAY_MAX ? container.max*2 : uint32_t(ARRAY_MAX);
+   uint16_t      *values=new(std::nothrow) uint16_t[max];
+   if(!values)
+      return(false);
+   memcpy(values,container.values,container.size*sizeof(uint16_t));
+   delete[] container.values;
+   container.values=values;
+   container.max   =max;
+   return(true);
+  }
+//+------------------------------------------------------------------+
+//| Position of the last run starting not after value, total if none |
+//+------------------------------------------------------------------+
+inline uint32_t CMTLoginSet::RunSearch(const uint16_t *runs,const uint32_t total,const uint16_t value)
+  {
+   uint32_t left=0,right=total;
+//--- search the first run starting after value
+   while(left<right)
+     {
+      const uint32_t middle=(left+right)/2;
+      if(runs[middle*2]<=value)
+         left=middle+1;
+      else
+         right=middle;
+     }
+   return(left ? left-1 : total);
+  }
+//+------------------------------------------------------------------+
+//| Set bits from first to last inclusive                            |
+//+------------------------------------------------------------------+
+inline void CMTLoginSet::BitmapSetRange(uint64_t *bits,const uint32_t first,const uint32_t last)
+  {
+   const uint32_t word_first=first>>6,word_last=last>>6;
+   const uint64_t mask_first=~uint64_t(0)<<(first&63),mask_last=~uint64_t(0)>>(63-(last&63));
+//--- one word
+   if(word_first==word_last)
+     {
+      bits[word_first]|=mask_first & mask_last;
+      return;
+     }
+//--- several words
+   bits[word_first]|=mask_first;
+   for(uint32_t i=word_first+1; i<word_last; i++)
+      bits[i]=~uint64_t(0);
+   bits[word_last]|=mask_last;
+  }
+//+------------------------------------------------------------------+
+//| Clear bits from first to last inclusive                          |
+//+------------------------------------------------------------------+
+inline void CMTLoginSet::BitmapClearRange(uint64_t *bits,const uint32_t first,const uint32_t last)
+  {
+   const uint32_t word_first=first>>6,word_last=last>>6;
+   const uint64_t mask_first=~uint64_t(0)<<(first&63),mask_last=~uint64_t(0)>>(63-(last&63));
+//--- one word
+   if(word_first==word_last)
+     {
+      bits[word_first]&=~(mask_first & mask_last);
+      return;
+     }
+//--- several words
+   bits[word_first]&=~mask_first;
+   for(uint32_t i=word_first+1; i<word_last; i++)
+      bits[i]=0;
+   bits[word_last]&=~mask_last;
+  }
+//+------------------------------------------------------------------+
+//| Set bits of runs                                                 |
+//+------------------------------------------------------------------+
+inline void CMTLoginSet::BitmapFromRuns(uint64_t *bits,const Container &container)
+  {
+   for(uint32_t i=0; i<container.size; i++)
+      BitmapSetRange(bits,container.values[i*2],uint32_t(container.values[i*2])+container.values[i*2+1]);
+  }
+//+------------------------------------------------------------------+
+//| dst|=src, returns bits total                                     |
+//+------------------------------------------------------------------+
+inline uint32_t CMTLoginSet::BitmapOr(uint64_t *dst,const uint64_t *src)
+  {
+   uint32_t i=0;
+#if defined(MTAPI_LOGINSET_AVX2)
+   for(; i<BITMAP_WORDS; i+=4)
+      _mm256_storeu_si256((__m256i*)(dst+i),_mm256_or_si256(_mm256_loadu_si256((const __m256i*)(dst+i)),_mm256_loadu_si256((const __m256i*)(src+i))));
+#elif defined(MTAPI_LOGINSET_SSE2)
+   for(; i<BITMAP_WORDS; i+=2)
+      _mm_storeu_si128((__m128i*)(dst+i),_mm_or_si128(_mm_loadu_si128((const __m128i*)(dst+i)),_mm_loadu_si128((const __m128i*)(src+i))));
+#endif
+   for(; i<BITMAP_WORDS; i++)
+      dst[i]|=src[i];
+   return(BitmapCount(dst));
+  }
+//+------------------------------------------------------------------+
+//| dst&=src, returns bits total                                     |
+//+------------------------------------------------------------------+
+inline uint32_t CMTLoginSet::BitmapAnd(uint64_t *dst,const uint64_t *src)
+  {
+   uint32_t i=0;
+#if defined(MTAPI_LOGINSET_AVX2)
+   for(; i<BITMAP_WORDS; i+=4)
+      _mm256_storeu_si256((__m256i*)(dst+i),_mm256_and_si256(_mm256_loadu_si256((const __m256i*)(dst+i)),_mm256_loadu_si256((const __m256i*)(src+i))));
+#elif defined(MTAPI_LOGINSET_SSE2)
+   for(; i<BITMAP_WORDS; i+=2)
+      _mm_storeu_si128((__m128i*)(dst+i),_mm_and_si128(_mm_loadu_si128((const __m128i*)(dst+i)),_mm_loadu_si128((const __m128i*)(src+i))));
+#endif
+   for(; i<BITMAP_WORDS; i++)
+      dst[i]&=src[i];
+   return(BitmapCount(dst));
+  }
+//+------------------------------------------------------------------+
+//| dst&=~src, returns bits total                                    |
+//+------------------------------------------------------------------+
+inline uint32_t CMTLoginSet::BitmapAndNot(uint64_t *dst,const uint64_t *src)
+  {
+   uint32_t i=0;
+#if defined(MTAPI_LOGINSET_AVX2)
+   for(; i<BITMAP_WORDS; i+=4)
+      _mm256_storeu_si256((__m256i*)(dst+i),_mm256_andnot_si256(_mm256_loadu_si256((const __m256i*)(src+i)),_mm256_loadu_si256((const __m256i*)(dst+i))));
+#elif defined(MTAPI_LOGINSET_SSE2)
+   for(; i<BITMAP_WORDS; i+=2)
+      _mm_storeu_si128((__m128i*)(dst+i),_mm_andnot_si128(_mm_loadu_si128((const __m128i*)(src+i)),_mm_loadu_si128((const __m128i*)(dst+i))));
+#endif
+   for(; i<BITMAP_WORDS; i++)
+      dst[i]&=~src[i];
+   return(BitmapCount(dst));
+  }
+//+------------------------------------------------------------------+
+//| Bits total                                                       |
+//+------------------------------------------------------------------+
+inline uint32_t CMTLoginSet::BitmapCount(const uint64_t *bits)
+  {
+   uint32_t count=0;
+   for(uint32_t i=0; i<BITMAP_WORDS; i++)
+      count+=BitCount(bits[i]);
+   return(count);
+  }
+//+------------------------------------------------------------------+
+//| Runs total, a run starts at set bit with clear previous bit      |
+//+------------------------------------------------------------------+
+inline uint32_t CMTLoginSet::BitmapRuns(const uint64_t *bits)
+  {
+   uint32_t count=0;
+   uint64_t carry=0;
+   for(uint32_t i=0; i<BITMAP_WORDS; i++)
+     {
+      count+=BitCount(bits[i] & ~((bits[i]<<1)|carry));
+      carry =bits[i]>>63;
+     }
+   return(count);
+  }
+//+------------------------------------------------------------------+
+//| Set bits total of word                                           |
+//+------------------------------------------------------------------+
+inline uint32_t CMTLoginSet::BitCount(const uint64_t value)
+  {
+#if defined(_MSC_VER) && defined(_M_X64) && defined(MTAPI_LOGINSET_AVX2)
+   return(uint32_t(__popcnt64(value)));
+#elif defined(__GNUC__)
+   return(uint32_t(__builtin_popcountll(value)));
+#else
+   uint64_t count=value-((value>>1) & 0x5555555555555555ULL);
+   count=(count & 0x3333333333333333ULL)+((count>>2) & 0x3333333333333333ULL);
+   count=(count+(count>>4)) & 0x0F0F0F0F0F0F0F0FULL;
+   return(uint32_t((count*0x0101010101010101ULL)>>56));
+#endif
+  }
+//+------------------------------------------------------------------+
+//| Index of the lowest set bit, value must not be zero              |
+//+------------------------------------------------------------------+
+inline uint32_t CMTLoginSet::LowestBit(const uint64_t value)
+  {
+#if defined(_MSC_VER)
+   unsigned long index=0;
+#if defined(_M_X64)
+   _BitScanForward64(&index,value);
+#else
+   if(!_BitScanForward(&index,uint32_t(value)))
+     {
+      _BitScanForward(&index,uint32_t(value>>32));
+      index+=32;
+     }
+#endif
+   return(uint32_t(index));
+#else
+   return(uint32_t(__builtin_ctzll(value)));
+#endif
+  }
+//+------------------------------------------------------------------+
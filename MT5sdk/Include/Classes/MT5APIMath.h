@@ -6,6 +6,11 @@
 #pragma once
 #include <string.h>
 #include <math.h>
+//--- SIMD array functions
+#if defined(__AVX2__)
+#define MTAPI_MATH_AVX2
+#include <immintrin.h>
+#endif
 //+------------------------------------------------------------------+
 //| Volume constants                                                 |
 //+------------------------------------------------------------------+
@@ -59,6 +64,19 @@ public:
    static double     MoneyAdd(const double left,const double right,const uint8_t digits);
    static bool       MoneyEqual(const double left,const double right,const uint8_t digits);
    static uint32_t   MoneyDigits(LPCWSTR currency);
+   //--- array functions, results are bit-identical to the scalar ones
+   static void       PriceNormalizeN(double *prices,const size_t count,uint32_t digits);
+   static void       PriceToIntN(const double *prices,int64_t *values,const size_t count,const uint32_t digits);
+   template<typename TTick>
+   static void       TicksToIntN(const TTick *ticks,const size_t count,const uint32_t digits,int64_t *bids,int64_t *asks);
+   static void       VolumeToDoubleN(const uint64_t *volumes,double *values,const size_t count);
+   static double     MoneySumN(const double *values,const size_t count,uint8_t digits);
+
+private:
+#ifdef MTAPI_MATH_AVX2
+   static bool       PriceNormalize4(const __m256d val,const uint32_t digits,double *res);
+   static bool       PriceToInt4(const __m256d price,const uint32_t digits,__m256i &res);
+#endif
   };
 //+------------------------------------------------------------------+
 //| 16 powers                                                        |
@@ -348,4 +366,199 @@ inline uint32_t SMTMath::MoneyDigits(LPCWSTR currency)
    return(2);
   }
 //+------------------------------------------------------------------+
-
+//+------------------------------------------------------------------+
+//| Prices array normalization                                       |
+//+------------------------------------------------------------------+
+inline void SMTMath::PriceNormalizeN(double *prices,const size_t count,uint32_t digits)
+  {
+   size_t i=0;
+//--- check
+   if(!prices)
+      return;
+   if(digits>MTAPI_PRICE_DIGITS_MAX)
+      digits=MTAPI_PRICE_DIGITS_MAX;
+#ifdef MTAPI_MATH_AVX2
+//--- by 4 prices, out of range quads are normalized below
+   for(; i+4<=count; i+=4)
+      if(!PriceNormalize4(_mm256_loadu_pd(prices+i),digits,prices+i))
+         for(size_t j=i; j<i+4; j++)
+            prices[j]=PriceNormalize(prices[j],digits);
+#endif
+//--- tail
+   for(; i<count; i++)
+      prices[i]=PriceNormalize(prices[i],digits);
+  }
+//+------------------------------------------------------------------+
+//| Prices array conversion from double to integer                   |
+//+------------------------------------------------------------------+
+inline void SMTMath::PriceToIntN(const double *prices,int64_t *values,const size_t count,const uint32_t digits)
+  {
+   size_t i=0;
+//--- check
+   if(!prices || !values)
+      return;
+#ifdef MTAPI_MATH_AVX2
+//--- by 4 prices
+   if(digits<=MTAPI_PRICE_DIGITS_MAX)
+      for(__m256i res; i+4<=count; i+=4)
+         if(PriceToInt4(_mm256_loadu_pd(prices+i),digits,res))
+            _mm256_storeu_si256((__m256i*)(values+i),res);
+         else
+            for(size_t j=i; j<i+4; j++)
+               values[j]=PriceToInt(prices[j],digits);
+#endif
+//--- tail
+   for(; i<count; i++)
+      values[i]=PriceToInt(prices[i],digits);
+  }
+//+------------------------------------------------------------------+
+//| Ticks array conversion to bid and ask integer columns            |
+//+------------------------------------------------------------------+
+template<typename TTick>
+inline void SMTMath::TicksToIntN(const TTick *ticks,const size_t count,const uint32_t digits,int64_t *bids,int64_t *asks)
+  {
+   size_t i=0;
+//--- check
+   if(!ticks || !bids || !asks)
+      return;
+#ifdef MTAPI_MATH_AVX2
+//--- by 4 ticks
+   if(digits<=MTAPI_PRICE_DIGITS_MAX)
+      for(__m256i res; i+4<=count; i+=4)
+        {
+         const TTick *tick=ticks+i;
+         //--- bid column
+         if(PriceToInt4(_mm256_set_pd(tick[3].bid,tick[2].bid,tick[1].bid,tick[0].bid),digits,res))
+            _mm256_storeu_si256((__m256i*)(bids+i),res);
+         else
+            for(size_t j=0; j<4; j++)
+               bids[i+j]=PriceToInt(tick[j].bid,digits);
+         //--- ask column
+         if(PriceToInt4(_mm256_set_pd(tick[3].ask,tick[2].ask,tick[1].ask,tick[0].ask),digits,res))
+            _mm256_storeu_si256((__m256i*)(asks+i),res);
+         else
+            for(size_t j=0; j<4; j++)
+               asks[i+j]=PriceToInt(tick[j].ask,digits);
+        }
+#endif
+//--- tail
+   for(; i<count; i++)
+     {
+      bids[i]=PriceToInt(ticks[i].bid,digits);
+      asks[i]=PriceToInt(ticks[i].ask,digits);
+     }
+  }
+//+------------------------------------------------------------------+
+//| Volumes array conversion from integer to double                  |
+//+------------------------------------------------------------------+
+inline void SMTMath::VolumeToDoubleN(const uint64_t *volumes,double *values,const size_t count)
+  {
+   size_t i=0;
+//--- check
+   if(!volumes || !values)
+      return;
+#ifdef MTAPI_MATH_AVX2
+   const __m256i exp52=_mm256_set1_epi64x(0x4330000000000000);
+   const __m256d pow52=_mm256_set1_pd(4503599627370496.0);
+   const __m256d div  =_mm256_set1_pd(MTAPI_VOLUME_DIV);
+//--- by 4 volumes
+   for(; i+4<=count; i+=4)
+     {
+      const __m256i volume=_mm256_loadu_si256((const __m256i*)(volumes+i));
+      //--- volumes below 2^52 are converted exactly by the exponent bits
+      if(_mm256_testz_si256(volume,_mm256_set1_epi64x(int64_t(0xFFF0000000000000))) &&
+         PriceNormalize4(_mm256_div_pd(_mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(volume,exp52)),pow52),div),MTAPI_VOLUME_DIGITS,values+i))
+         continue;
+      //--- huge volumes
+      for(size_t j=i; j<i+4; j++)
+         values[j]=VolumeToDouble(volumes[j]);
+     }
+#endif
+//--- tail
+   for(; i<count; i++)
+      values[i]=VolumeToDouble(volumes[i]);
+  }
+//+------------------------------------------------------------------+
+//| Money array sum                                                  |
+//| values are rounded to digits once and added as integers, so the  |
+//| result does not depend on the order and equals the MoneyAdd      |
+//| chain if values are already rounded to digits, for not rounded   |
+//| values the chain rounds partial sums instead and may differ,     |
+//| e.g. 0.004 and 0.004 with 2 digits give 0.00 here, but           |
+//| MoneyAdd(0.004,0.004,2) is 0.01                                  |
+//+------------------------------------------------------------------+
+inline double SMTMath::MoneySumN(const double *values,const size_t count,uint8_t digits)
+  {
+   uint64_t sum=0;
+   size_t   i  =0;
+//--- check
+   if(!values)
+      return(0.0);
+   if(digits>MTAPI_PRICE_DIGITS_MAX)
+      digits=MTAPI_PRICE_DIGITS_MAX;
+#ifdef MTAPI_MATH_AVX2
+//--- by 4 values
+   __m256i sum4=_mm256_setzero_si256(),res;
+   for(; i+4<=count; i+=4)
+      if(PriceToInt4(_mm256_loadu_pd(values+i),digits,res))
+         sum4=_mm256_add_epi64(sum4,res);
+      else
+         for(size_t j=i; j<i+4; j++)
+            sum+=uint64_t(PriceToInt(values[j],digits));
+//--- horizontal sum
+   uint64_t sums[4];
+   _mm256_storeu_si256((__m256i*)sums,sum4);
+   sum+=sums[0]+sums[1]+sums[2]+sums[3];
+#endif
+//--- tail
+   for(; i<count; i++)
+      sum+=uint64_t(PriceToInt(values[i],digits));
+//--- result
+   return(PriceToDouble(int64_t(sum),digits));
+  }
+#ifdef MTAPI_MATH_AVX2
+//+------------------------------------------------------------------+
+//| Normalization of 4 prices, repeats PriceNormalize step by step   |
+//| false if some price does not fit to int64                        |
+//+------------------------------------------------------------------+
+inline bool SMTMath::PriceNormalize4(const __m256d val,const uint32_t digits,double *res)
+  {
+   const __m256d zero=_mm256_setzero_pd();
+//--- check range, NaN fails too
+   const __m256d abs_val=_mm256_andnot_pd(_mm256_set1_pd(-0.0),val);
+   if(_mm256_movemask_pd(_mm256_cmp_pd(abs_val,_mm256_set1_pd(9223372036854775808.0),_CMP_LT_OQ))!=0xF)
+      return(false);
+//--- integer part, adding zero turns -0.0 into 0.0 as double(__int64(val)) does
+   const __m256d p      =_mm256_set1_pd(s_decimal[digits]);
+   const __m256d integer=_mm256_add_pd(_mm256_round_pd(val,_MM_FROUND_TO_ZERO|_MM_FROUND_NO_EXC),zero);
+   __m256d       fract  =_mm256_mul_pd(_mm256_sub_pd(val,integer),p);
+//--- rounding by sign
+   const __m256d rounder=_mm256_set1_pd(s_rounder_math);
+   fract=_mm256_blendv_pd(_mm256_sub_pd(fract,rounder),_mm256_add_pd(fract,rounder),_mm256_cmp_pd(val,zero,_CMP_GT_OQ));
+   fract=_mm256_add_pd(_mm256_round_pd(fract,_MM_FROUND_TO_ZERO|_MM_FROUND_NO_EXC),zero);
+//--- summary
+   _mm256_storeu_pd(res,_mm256_add_pd(integer,_mm256_div_pd(fract,p)));
+   return(true);
+  }
+//+------------------------------------------------------------------+
+//| Conversion of 4 prices to integer, repeats PriceToInt fast path  |
+//| false if some price needs the integer multiply                   |
+//+------------------------------------------------------------------+
+inline bool SMTMath::PriceToInt4(const __m256d price,const uint32_t digits,__m256i &res)
+  {
+//--- check complexity, NaN fails too
+   const __m256d abs_price=_mm256_andnot_pd(_mm256_set1_pd(-0.0),price);
+   if(_mm256_movemask_pd(_mm256_cmp_pd(abs_price,_mm256_set1_pd(s_double_max[digits]),_CMP_LT_OQ))!=0xF)
+      return(false);
+//--- scale and round by sign
+   const __m256d scaled =_mm256_mul_pd(price,_mm256_set1_pd(s_decimal[digits]));
+   const __m256d rounder=_mm256_set1_pd(s_rounder_math);
+   __m256d       value  =_mm256_blendv_pd(_mm256_sub_pd(scaled,rounder),_mm256_add_pd(scaled,rounder),_mm256_cmp_pd(price,_mm256_setzero_pd(),_CMP_GE_OQ));
+   value=_mm256_round_pd(value,_MM_FROUND_TO_ZERO|_MM_FROUND_NO_EXC);
+//--- integers below 2^51 are exact in the mantissa of 1.5*2^52
+   const __m256d magic=_mm256_set1_pd(6755399441055744.0);
+   res=_mm256_sub_epi64(_mm256_castpd_si256(_mm256_add_pd(value,magic)),_mm256_castpd_si256(magic));
+   return(true);
+  }
+#endif
+//+------------------------------------------------------------------+
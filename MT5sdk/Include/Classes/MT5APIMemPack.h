@@ -15,6 +15,8 @@ private:
      {
       REALLOC_STEP  =1024                  // buffer reallocation step
      };
+   //--- maximum buffer size, enumerators are int and can not hold it
+   static const uint32_t REALLOC_MAX=0xFFFFFFFF;
 
 private:
    //--- data
@@ -30,6 +32,7 @@ public:
    void              Clear()         { m_buffer_len=0; }
    void              Shutdown(void);
    bool              Reallocate(uint32_t growsize);
+   bool              Reserve(uint32_t len);
    //--- add unformatted data
    bool              Add(const void *buf,uint32_t len);
    //--- swap array contents
@@ -66,7 +69,7 @@ inline bool CMTMemPack::Add(const void *buf,uint32_t len)
       return(false);
 //--- check for exceeding buffer size
    if(m_buffer==NULL || (len+m_buffer_len)>m_buffer_max)
-      if(!Reallocate(len+m_buffer_len+REALLOC_STEP))
+      if(!Reserve(len))
          return(false);
 //--- append data to buffer
    memcpy(&m_buffer[m_buffer_len],buf,len);
@@ -75,6 +78,26 @@ inline bool CMTMemPack::Add(const void *buf,uint32_t len)
    return(true);
   }
 //+------------------------------------------------------------------+
+//| Reserve space for len more bytes with geometric growth           |
+//+------------------------------------------------------------------+
+inline bool CMTMemPack::Reserve(uint32_t len)
+  {
+   uint64_t need=uint64_t(m_buffer_len)+len;
+//--- check for overflow
+   if(need>REALLOC_MAX)
+      return(false);
+   if(need<=m_buffer_max && m_buffer)
+      return(true);
+//--- grow by half of the current size, so appending is amortized linear
+   uint64_t growsize=uint64_t(m_buffer_max)+m_buffer_max/2;
+   if(growsize<need+REALLOC_STEP)
+      growsize=need+REALLOC_STEP;
+   if(growsize>REALLOC_MAX)
+      growsize=REALLOC_MAX;
+//---
+   return(Reallocate(uint32_t(growsize)));
+  }
+//+------------------------------------------------------------------+
 //| Swap buffer contents                                             |
 //+------------------------------------------------------------------+
 inline void CMTMemPack::Swap(CMTMemPack &pack)
@@ -130,3 +153,196 @@ inline bool CMTMemPack::Reallocate(uint32_t growsize)
    return(true);
   }
 //+------------------------------------------------------------------+
+//| Memory segment for scatter-gather output                         |
+//+------------------------------------------------------------------+
+struct MTMemPackSegment
+  {
+   const char       *buf;                 // data
+   uint32_t          len;                 // data length
+  };
+//+------------------------------------------------------------------+
+//| Class of chunked memory block                                    |
+//| data is stored in the fixed size chunks without reallocation,    |
+//| chunks are kept on Clear and reused                              |
+//+------------------------------------------------------------------+
+class CMTMemPackChunked
+  {
+private:
+   //--- constants
+   enum
+     {
+      CHUNK_SIZE    =64*1024,              // default chunk size
+      CHUNKS_STEP   =16                    // chunks array reallocation step
+     };
+
+private:
+   //--- data
+   char            **m_chunks;             // chunks
+   uint32_t          m_chunks_total;       // allocated chunks
+   uint32_t          m_chunks_max;         // size of chunks array
+   uint32_t          m_chunk_size;         // chunk size
+   uint64_t          m_buffer_len;         // data length
+
+public:
+   //--- constructor/destructor
+   explicit          CMTMemPackChunked(uint32_t chunk_size=CHUNK_SIZE);
+                    ~CMTMemPackChunked(void);
+   //--- correct the length in block
+   void              Clear()         { m_buffer_len=0; }
+   void              Shutdown(void);
+   //--- add unformatted data
+   bool              Add(const void *buf,uint32_t len);
+   //--- swap contents
+   void              Swap(CMTMemPackChunked &pack);
+   //--- data access
+   uint64_t          Len(void) const     { return(m_buffer_len); }
+   uint32_t          SegmentsTotal(void) const { return(uint32_t((m_buffer_len+m_chunk_size-1)/m_chunk_size)); }
+   uint32_t          Segments(MTMemPackSegment *segments,uint32_t segments_max,uint32_t first=0) const;
+
+private:
+   bool              ChunkAdd(void);
+  };
+//+------------------------------------------------------------------+
+//| Constructor                                                      |
+//+------------------------------------------------------------------+
+inline CMTMemPackChunked::CMTMemPackChunked(uint32_t chunk_size)
+   : m_chunks(NULL),
+     m_chunks_total(0),
+     m_chunks_max(0),
+     m_chunk_size(chunk_size ? chunk_size : CHUNK_SIZE),
+     m_buffer_len(0)
+  {
+  }
+//+------------------------------------------------------------------+
+//| Destructor                                                       |
+//+------------------------------------------------------------------+
+inline CMTMemPackChunked::~CMTMemPackChunked(void)
+  {
+   Shutdown();
+  }
+//+------------------------------------------------------------------+
+//| Add data to chunks                                               |
+//+------------------------------------------------------------------+
+inline bool CMTMemPackChunked::Add(const void *buf,uint32_t len)
+  {
+   const char *src=(const char*)buf;
+//--- check
+   if(!buf)
+      return(false);
+//--- allocate all required chunks before copying, data is added entirely or not at all
+   uint64_t chunks=(m_buffer_len+len+m_chunk_size-1)/m_chunk_size;
+   while(m_chunks_total<chunks)
+      if(!ChunkAdd())
+         return(false);
+//--- copy by chunks
+   while(len>0)
+     {
+      uint32_t idx   =uint32_t(m_buffer_len/m_chunk_size);
+      uint32_t offset=uint32_t(m_buffer_len%m_chunk_size);
+      //--- append data to chunk
+      uint32_t copy=m_chunk_size-offset;
+      if(copy>len)
+         copy=len;
+      memcpy(m_chunks[idx]+offset,src,copy);
+      m_buffer_len+=copy;
+      src         +=copy;
+      len         -=copy;
+     }
+//---
+   return(true);
+  }
+//+------------------------------------------------------------------+
+//| Get data segments starting from the specified one                |
+//+------------------------------------------------------------------+
+inline uint32_t CMTMemPackChunked::Segments(MTMemPackSegment *segments,uint32_t segments_max,uint32_t first) const
+  {
+   uint32_t total=SegmentsTotal(),count=0;
+//--- check
+   if(!segments)
+      return(0);
+//--- fill segments
+   for(uint32_t i=first; i<total && count<segments_max; i++,count++)
+     {
+      segments[count].buf=m_chunks[i];
+      segments[count].len=(i+1<total) ? m_chunk_size : uint32_t(m_buffer_len-uint64_t(i)*m_chunk_size);
+     }
+//---
+   return(count);
+  }
+//+------------------------------------------------------------------+
+//| Swap contents                                                    |
+//+------------------------------------------------------------------+
+inline void CMTMemPackChunked::Swap(CMTMemPackChunked &pack)
+  {
+   char    **chunks;             // chunks
+   uint32_t  chunks_total;       // allocated chunks
+   uint32_t  chunks_max;         // size of chunks array
+   uint32_t  chunk_size;         // chunk size
+   uint64_t  buffer_len;         // data length
+//--- check
+   if(this==&pack)
+      return;
+//--- swap, remember own chunks
+   chunks      =m_chunks;
+   chunks_total=m_chunks_total;
+   chunks_max  =m_chunks_max;
+   chunk_size  =m_chunk_size;
+   buffer_len  =m_buffer_len;
+//--- replace chunks with received ones
+   m_chunks      =pack.m_chunks;
+   m_chunks_total=pack.m_chunks_total;
+   m_chunks_max  =pack.m_chunks_max;
+   m_chunk_size  =pack.m_chunk_size;
+   m_buffer_len  =pack.m_buffer_len;
+//--- return own chunks
+   pack.m_chunks      =chunks;
+   pack.m_chunks_total=chunks_total;
+   pack.m_chunks_max  =chunks_max;
+   pack.m_chunk_size  =chunk_size;
+   pack.m_buffer_len  =buffer_len;
+  }
+//+------------------------------------------------------------------+
+//| Deallocate all chunks                                            |
+//+------------------------------------------------------------------+
+inline void CMTMemPackChunked::Shutdown(void)
+  {
+   if(m_chunks)
+     {
+      for(uint32_t i=0; i<m_chunks_total; i++)
+         delete[] m_chunks[i];
+      delete[] m_chunks;
+      m_chunks=NULL;
+     }
+   m_chunks_total=0;
+   m_chunks_max  =0;
+   m_buffer_len  =0;
+  }
+//+------------------------------------------------------------------+
+//| Allocate new chunk                                               |
+//+------------------------------------------------------------------+
+inline bool CMTMemPackChunked::ChunkAdd(void)
+  {
+   char *chunk;
+//--- grow chunks array, only pointers are copied
+   if(m_chunks_total>=m_chunks_max)
+     {
+      uint32_t chunks_max=m_chunks_max+m_chunks_max/2+CHUNKS_STEP;
+      char   **chunks;
+      if((chunks=new(std::nothrow) char*[chunks_max])==NULL)
+         return(false);
+      if(m_chunks)
+        {
+         if(m_chunks_total>0) memcpy(chunks,m_chunks,sizeof(char*)*m_chunks_total);
+         delete[] m_chunks;
+        }
+      m_chunks    =chunks;
+      m_chunks_max=chunks_max;
+     }
+//--- allocate chunk
+   if((chunk=new(std::nothrow) char[m_chunk_size])==NULL)
+      return(false);
+   m_chunks[m_chunks_total++]=chunk;
+//---
+   return(true);
+  }
+//+------------------------------------------------------------------+
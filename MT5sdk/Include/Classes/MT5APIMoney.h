@@ -0,0 +1,77 @@
+//+------------------------------------------------------------------+
+//|                                                 MetaTrader 5 API |
+//|                             Copyright 2000-2025, MetaQuotes Ltd. |
+//|                                               www.metaquotes.net |
+//+------------------------------------------------------------------+
+#pragma once
+#include "MT5APIMath.h"
+//+------------------------------------------------------------------+
+//| Fixed point money                                                |
+//| amount is stored as integer number of 10^-digits units,          |
+//| digits are the scale of the currency and are kept by the owner,  |
+//| addition and subtraction are exact and need no normalization,    |
+//| the structure is POD and may be zero initialized by {0}          |
+//+------------------------------------------------------------------+
+struct MTMoney
+  {
+   int64_t           value;                     // amount in 10^-digits units
+   //--- conversion from/to double
+   static MTMoney    FromDouble(const double amount,const uint32_t digits);
+   double            ToDouble(const uint32_t digits) const;
+   //--- array functions
+   static void       FromDoubleN(const double *amounts,MTMoney *money,const size_t count,const uint32_t digits);
+   static MTMoney    SumN(const MTMoney *money,const size_t count);
+   //--- checks
+   bool              IsZero(void) const                  { return(value==0);        }
+   //--- arithmetic
+   MTMoney           operator-(void) const               { MTMoney res={-value}; return(res); }
+   MTMoney           operator+(const MTMoney &r) const   { MTMoney res={value+r.value}; return(res); }
+   MTMoney           operator-(const MTMoney &r) const   { MTMoney res={value-r.value}; return(res); }
+   MTMoney&          operator+=(const MTMoney &r)        { value+=r.value; return(*this); }
+   MTMoney&          operator-=(const MTMoney &r)        { value-=r.value; return(*this); }
+   //--- comparison
+   bool              operator==(const MTMoney &r) const  { return(value==r.value);  }
+   bool              operator!=(const MTMoney &r) const  { return(value!=r.value);  }
+   bool              operator<(const MTMoney &r) const   { return(value<r.value);   }
+   bool              operator>(const MTMoney &r) const   { return(value>r.value);   }
+   bool              operator<=(const MTMoney &r) const  { return(value<=r.value);  }
+   bool              operator>=(const MTMoney &r) const  { return(value>=r.value);  }
+  };
+//+------------------------------------------------------------------+
+//| Conversion from double, rounded to digits                        |
+//+------------------------------------------------------------------+
+inline MTMoney MTMoney::FromDouble(const double amount,const uint32_t digits)
+  {
+   MTMoney res={SMTMath::PriceToInt(amount,digits)};
+   return(res);
+  }
+//+------------------------------------------------------------------+
+//| Conversion to normalized double                                  |
+//+------------------------------------------------------------------+
+inline double MTMoney::ToDouble(const uint32_t digits) const
+  {
+   return(SMTMath::PriceToDouble(value,digits));
+  }
+//+------------------------------------------------------------------+
+//| Array conversion from double                                     |
+//+------------------------------------------------------------------+
+inline void MTMoney::FromDoubleN(const double *amounts,MTMoney *money,const size_t count,const uint32_t digits)
+  {
+   static_assert(sizeof(MTMoney)==sizeof(int64_t),"MTMoney must be a plain int64_t");
+   SMTMath::PriceToIntN(amounts,(int64_t*)money,count,digits);
+  }
+//+------------------------------------------------------------------+
+//| Array sum, the loop is vectorized by compiler                    |
+//+------------------------------------------------------------------+
+inline MTMoney MTMoney::SumN(const MTMoney *money,const size_t count)
+  {
+   uint64_t sum=0;
+//--- check
+   if(money)
+      for(size_t i=0; i<count; i++)
+         sum+=uint64_t(money[i].value);
+//--- result
+   MTMoney res={int64_t(sum)};
+   return(res);
+  }
+//+------------------------------------------------------------------+
@@ -0,0 +1,389 @@
+//+------------------------------------------------------------------+
+//|                                                 MetaTrader 5 API |
+//|                             Copyright 2000-2025, MetaQuotes Ltd. |
+//|                                               www.metaquotes.net |
+//+------------------------------------------------------------------+
+#pragma once
+#include <new.h>
+#include <atomic>
+#include <type_traits>
+//+------------------------------------------------------------------+
+//| Event count, wakeup of a consumer without lost notifications     |
+//| consumer: epoch=PrepareWait(), recheck the condition,            |
+//|           then CancelWait() or Wait(epoch)                       |
+//| producer: change the condition, then Notify()                    |
+//| Notify is a memory barrier and a check while nobody waits        |
+//+------------------------------------------------------------------+
+class CMTEventCount
+  {
+private:
+   volatile LONG     m_epoch;                // notifications counter
+   volatile LONG     m_waiters;              // waiting threads
+   SRWLOCK           m_lock;                 // lock of condition
+   CONDITION_VARIABLE m_cond;                // condition of epoch change
+
+public:
+                     CMTEventCount(void) : m_epoch(0),m_waiters(0) { InitializeSRWLock(&m_lock); InitializeConditionVariable(&m_cond); }
+                    ~CMTEventCount(void)                           {                                                                  }
+   //--- wait preparation, interlocked operation is a full barrier
+   LONG              PrepareWait(void)       { InterlockedIncrement(&m_waiters); return(m_epoch); }
+   void              CancelWait(void)        { InterlockedDecrement(&m_waiters);                  }
+   //+------------------------------------------------------------------+
+   //| Wait for notification after epoch, false on timeout              |
+   //+------------------------------------------------------------------+
+   bool Wait(const LONG epoch,const DWORD timeout=INFINITE)
+     {
+      bool res=true;
+      AcquireSRWLockExclusive(&m_lock);
+      while(m_epoch==epoch && res)
+         res=(SleepConditionVariableSRW(&m_cond,&m_lock,timeout,0)!=FALSE);
+      ReleaseSRWLockExclusive(&m_lock);
+      InterlockedDecrement(&m_waiters);
+      return(res || m_epoch!=epoch);
+     }
+   //+------------------------------------------------------------------+
+   //| Wake waiting threads                                             |
+   //+------------------------------------------------------------------+
+   void Notify(void)
+     {
+      //--- condition change must be visible before waiters check
+      MemoryBarrier();
+      if(!m_waiters)
+         return;
+      AcquireSRWLockExclusive(&m_lock);
+      InterlockedIncrement(&m_epoch);
+      WakeAllConditionVariable(&m_cond);
+      ReleaseSRWLockExclusive(&m_lock);
+     }
+
+private:
+   //--- prohibit copy constructor and assignment
+                     CMTEventCount(const CMTEventCount&)=delete;
+   CMTEventCount&    operator=(const CMTEventCount&)=delete;
+  };
+//+------------------------------------------------------------------+
+//| Bounded lock-free queue, single producer and single consumer     |
+//| only POD records, Push returns false if the queue is full        |
+//+------------------------------------------------------------------+
+template <typename T>
+class TMTQueueSPSC
+  {
+   //--- check record type
+                     static_assert(std::is_trivially_copyable<T>::value,"Queue records must be trivially copyable");
+
+private:
+   //--- consumer side
+   alignas(64) std::atomic<uint64_t> m_head;  // next record to pop
+   uint64_t          m_tail_cache;           // last seen tail
+   //--- producer side
+   alignas(64) std::atomic<uint64_t> m_tail;  // next record to push
+   uint64_t          m_head_cache;           // last seen head
+   //--- shared
+   alignas(64) T    *m_records;              // ring buffer
+   uint64_t          m_mask;                 // ring size - 1
+   CMTEventCount     m_event;                // consumer wakeup
+   volatile LONG     m_wake;                 // wakeup without records
+
+public:
+   //+------------------------------------------------------------------+
+   //| Constructor                                                      |
+   //+------------------------------------------------------------------+
+   TMTQueueSPSC(void) : m_head(0),m_tail_cache(0),m_tail(0),m_head_cache(0),m_records(NULL),m_mask(0),m_wake(0)
+     {
+     }
+   //+------------------------------------------------------------------+
+   //| Destructor                                                       |
+   //+------------------------------------------------------------------+
+   ~TMTQueueSPSC(void)
+     {
+      Shutdown();
+     }
+   //+------------------------------------------------------------------+
+   //| Allocate ring, capacity is rounded up to power of 2              |
+   //+------------------------------------------------------------------+
+   bool Initialize(const uint32_t capacity)
+     {
+      Shutdown();
+      //--- ring size
+      uint64_t size=2;
+      while(size<capacity)
+         size*=2;
+      if((m_records=new(std::nothrow) T[size])==NULL)
+         return(false);
+      m_mask=size-1;
+      return(true);
+     }
+   //+------------------------------------------------------------------+
+   //| Free ring, no producers and consumer must be active              |
+   //+------------------------------------------------------------------+
+   void Shutdown(void)
+     {
+      if(m_records)
+        {
+         delete[] m_records;
+         m_records=NULL;
+        }
+      m_mask=0;
+      m_head.store(0,std::memory_order_relaxed);
+      m_tail.store(0,std::memory_order_relaxed);
+      m_head_cache=m_tail_cache=0;
+     }
+   //+------------------------------------------------------------------+
+   //| Push record, producer thread only                                |
+   //+------------------------------------------------------------------+
+   bool Push(const T &record)
+     {
+      const uint64_t tail=m_tail.load(std::memory_order_relaxed);
+      //--- check free space, reread head only when cached one says full
+      if(!m_records)
+         return(false);
+      if(tail-m_head_cache>m_mask)
+        {
+         m_head_cache=m_head.load(std::memory_order_acquire);
+         if(tail-m_head_cache>m_mask)
+            return(false);
+        }
+      //--- write and publish
+      m_records[tail & m_mask]=record;
+      m_tail.store(tail+1,std::memory_order_release);
+      m_event.Notify();
+      return(true);
+     }
+   //+------------------------------------------------------------------+
+   //| Pop record, consumer thread only                                 |
+   //+------------------------------------------------------------------+
+   bool Pop(T &record)
+     {
+      return(PopBatch(&record,1)==1);
+     }
+   //+------------------------------------------------------------------+
+   //| Pop up to max records, consumer thread only                      |
+   //+------------------------------------------------------------------+
+   uint32_t PopBatch(T *records,const uint32_t max)
+     {
+      const uint64_t head=m_head.load(std::memory_order_relaxed);
+      //--- available records, reread tail only when cached one says empty
+      if(head==m_tail_cache)
+        {
+         m_tail_cache=m_tail.load(std::memory_order_acquire);
+         if(head==m_tail_cache)
+            return(0);
+        }
+      uint64_t count=m_tail_cache-head;
+      if(count>max)
+         count=max;
+      //--- copy and release space
+      for(uint64_t i=0; i<count; i++)
+         records[i]=m_records[(head+i) & m_mask];
+      m_head.store(head+count,std::memory_order_release);
+      return(uint32_t(count));
+     }
+   //+------------------------------------------------------------------+
+   //| Wait for records, consumer thread only                           |
+   //| returns on records, Wake call or timeout                         |
+   //+------------------------------------------------------------------+
+   void Wait(const DWORD timeout=INFINITE)
+     {
+      const LONG epoch=m_event.PrepareWait();
+      if(!Empty() || m_wake)
+         m_event.CancelWait();
+      else
+         m_event.Wait(epoch,timeout);
+      InterlockedExchange(&m_wake,0);
+     }
+   //+------------------------------------------------------------------+
+   //| Wake consumer, for example to stop it,                           |
+   //| the current or the next Wait returns                             |
+   //+------------------------------------------------------------------+
+   void Wake(void)
+     {
+      InterlockedExchange(&m_wake,1);
+      m_event.Notify();
+     }
+   //+------------------------------------------------------------------+
+   //| Queue state                                                      |
+   //+------------------------------------------------------------------+
+   bool     Empty(void) const    { return(m_head.load(std::memory_order_acquire)==m_tail.load(std::memory_order_acquire)); }
+   uint64_t Pushed(void) const   { return(m_tail.load(std::memory_order_acquire));                                          }
+   uint64_t Popped(void) const   { return(m_head.load(std::memory_order_acquire));                                          }
+
+private:
+   //--- prohibit copy constructor and assignment
+                     TMTQueueSPSC(const TMTQueueSPSC&)=delete;
+   TMTQueueSPSC&     operator=(const TMTQueueSPSC&)=delete;
+  };
+//+------------------------------------------------------------------+
+//| Bounded lock-free queue, multiple producers and single consumer  |
+//| each cell has a sequence number: producers reserve positions     |
+//| by CAS and publish cells independently, the consumer takes       |
+//| published cells in order                                         |
+//| only POD records, Push returns false if the queue is full        |
+//+------------------------------------------------------------------+
+template <typename T>
+class TMTQueueMPSC
+  {
+   //--- check record type
+                     static_assert(std::is_trivially_copyable<T>::value,"Queue records must be trivially copyable");
+   //--- ring cell
+   struct Cell
+     {
+      std::atomic<uint64_t> sequence;        // position+1 if published, position if free
+      T                 record;              // record
+     };
+
+private:
+   alignas(64) std::atomic<uint64_t> m_tail;  // next position to reserve
+   alignas(64) uint64_t m_head;              // next position to pop, consumer only
+   std::atomic<uint64_t> m_popped;           // popped records, for observers
+   alignas(64) Cell *m_cells;                // ring buffer
+   uint64_t          m_mask;                 // ring size - 1
+   CMTEventCount     m_event;                // consumer wakeup
+   volatile LONG     m_wake;                 // wakeup without records
+
+public:
+   //+------------------------------------------------------------------+
+   //| Constructor                                                      |
+   //+------------------------------------------------------------------+
+   TMTQueueMPSC(void) : m_tail(0),m_head(0),m_popped(0),m_cells(NULL),m_mask(0),m_wake(0)
+     {
+     }
+   //+------------------------------------------------------------------+
+   //| Destructor                                                       |
+   //+------------------------------------------------------------------+
+   ~TMTQueueMPSC(void)
+     {
+      Shutdown();
+     }
+   //+------------------------------------------------------------------+
+   //| Allocate ring, capacity is rounded up to power of 2              |
+   //+------------------------------------------------------------------+
+   bool Initialize(const uint32_t capacity)
+     {
+      Shutdown();
+      //--- ring size
+      uint64_t size=2;
+      while(size<capacity)
+         size*=2;
+      if((m_cells=new(std::nothrow) Cell[size])==NULL)
+         return(false);
+      for(uint64_t i=0; i<size; i++)
+         m_cells[i].sequence.store(i,std::memory_order_relaxed);
+      m_mask=size-1;
+      return(true);
+     }
+   //+------------------------------------------------------------------+
+   //| Free ring, no producers and consumer must be active              |
+   //+------------------------------------------------------------------+
+   void Shutdown(void)
+     {
+      if(m_cells)
+        {
+         delete[] m_cells;
+         m_cells=NULL;
+        }
+      m_mask=0;
+      m_head=0;
+      m_tail.store(0,std::memory_order_relaxed);
+      m_popped.store(0,std::memory_order_relaxed);
+     }
+   //+------------------------------------------------------------------+
+   //| Push record, any thread                                          |
+   //+------------------------------------------------------------------+
+   bool Push(const T &record)
+     {
+      //--- check
+      if(!m_cells)
+         return(false);
+      //--- reserve position
+      uint64_t pos=m_tail.load(std::memory_order_relaxed);
+      Cell    *cell;
+      for(;;)
+        {
+         cell=&m_cells[pos & m_mask];
+         const int64_t diff=int64_t(cell->sequence.load(std::memory_order_acquire)-pos);
+         //--- free cell, try to take it
+         if(diff==0)
+           {
+            if(m_tail.compare_exchange_weak(pos,pos+1,std::memory_order_relaxed))
+               break;
+           }
+         else
+           {
+            //--- the cell of previous round is not popped yet, queue is full
+            if(diff<0)
+               return(false);
+            //--- taken by other producer
+            pos=m_tail.load(std::memory_order_relaxed);
+           }
+        }
+      //--- write and publish
+      cell->record=record;
+      cell->sequence.store(pos+1,std::memory_order_release);
+      m_event.Notify();
+      return(true);
+     }
+   //+------------------------------------------------------------------+
+   //| Pop record, consumer thread only                                 |
+   //+------------------------------------------------------------------+
+   bool Pop(T &record)
+     {
+      return(PopBatch(&record,1)==1);
+     }
+   //+------------------------------------------------------------------+
+   //| Pop up to max published records in order, consumer thread only   |
+   //+------------------------------------------------------------------+
+   uint32_t PopBatch(T *records,const uint32_t max)
+     {
+      uint32_t count=0;
+      //--- check
+      if(!m_cells)
+         return(0);
+      //--- take published cells
+      for(; count<max; count++,m_head++)
+        {
+         Cell &cell=m_cells[m_head & m_mask];
+         if(cell.sequence.load(std::memory_order_acquire)!=m_head+1)
+            break;
+         records[count]=cell.record;
+         //--- free the cell for the next round
+         cell.sequence.store(m_head+m_mask+1,std::memory_order_release);
+        }
+      if(count)
+         m_popped.fetch_add(count,std::memory_order_release);
+      return(count);
+     }
+   //+------------------------------------------------------------------+
+   //| Wait for records, consumer thread only                           |
+   //| returns on records, Wake call or timeout                         |
+   //+------------------------------------------------------------------+
+   void Wait(const DWORD timeout=INFINITE)
+     {
+      const LONG epoch=m_event.PrepareWait();
+      if(!Empty() || m_wake)
+         m_event.CancelWait();
+      else
+         m_event.Wait(epoch,timeout);
+      InterlockedExchange(&m_wake,0);
+     }
+   //+------------------------------------------------------------------+
+   //| Wake consumer, for example to stop it,                           |
+   //| the current or the next Wait returns                             |
+   //+------------------------------------------------------------------+
+   void Wake(void)
+     {
+      InterlockedExchange(&m_wake,1);
+      m_event.Notify();
+     }
+   //+------------------------------------------------------------------+
+   //| Queue state, reserved but not published records are counted     |
+   //+------------------------------------------------------------------+
+   bool     Empty(void) const    { return(m_popped.load(std::memory_order_acquire)==m_tail.load(std::memory_order_acquire)); }
+   uint64_t Pushed(void) const   { return(m_tail.load(std::memory_order_acquire));                                            }
+   uint64_t Popped(void) const   { return(m_popped.load(std::memory_order_acquire));                                          }
+
+private:
+   //--- prohibit copy constructor and assignment
+                     TMTQueueMPSC(const TMTQueueMPSC&)=delete;
+   TMTQueueMPSC&     operator=(const TMTQueueMPSC&)=delete;
+  };
+//+------------------------------------------------------------------+
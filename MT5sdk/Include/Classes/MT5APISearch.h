@@ -4,6 +4,9 @@
 //|                                               www.metaquotes.net |
 //+------------------------------------------------------------------+
 #pragma once
+#include <algorithm>
+#include <type_traits>
+#include <utility>
 //+------------------------------------------------------------------+
 //| Search functions                                                 |
 //+------------------------------------------------------------------+
@@ -25,7 +28,50 @@ public:
    static void*      SearchLess(const void *key,void *base,size_t total,const size_t width,SortFunctionPtr compare);
    static void*      SearchLeft(const void *key,void *base,size_t total,const size_t width,SortFunctionPtr compare);
    static void*      SearchRight(const void *key,void *base,size_t total,const size_t width,SortFunctionPtr compare);
+   //--- pattern-defeating quick sort with inlined comparator, less(a,b) is strict weak ordering
+   template <class T,class TLess>
+   static void       Sort(T *base,size_t total,TLess less);
+   //--- branchless binary search by key extractor, key_fn(record) is compared with key by operator<
+   template <class T,class TKey,class TKeyFn>
+   static T*         LowerBound(T *base,size_t total,const TKey &key,TKeyFn key_fn);
+   template <class T,class TKey,class TKeyFn>
+   static T*         UpperBound(T *base,size_t total,const TKey &key,TKeyFn key_fn);
+   //--- stable LSD radix sort of POD records by integer key key_fn(record), 8, 11 or 16 bits per digit
+   template <uint32_t TDigitBits=11,class T,class TKeyFn>
+   static void       RadixSort(T *base,size_t total,TKeyFn key_fn);
+
 private:
+   //--- pattern-defeating quick sort constants
+   enum
+     {
+      SORT_INSERTION_THRESHOLD=24,         // insertion sort for smaller ranges
+      SORT_NINTHER_THRESHOLD  =128,        // pseudomedian of 9 for greater ranges
+      SORT_PARTIAL_LIMIT      =8,          // moves limit of the partial insertion sort
+      SORT_BLOCK_SIZE         =64,         // block size of the branchless partition
+      SORT_RADIX_THRESHOLD    =1024        // comparison sort for smaller arrays in radix sort
+     };
+   //--- pattern-defeating quick sort
+   template <class T,class TLess>
+   static void       SortLoop(T *begin,T *end,TLess &less,int bad_allowed,bool leftmost);
+   template <class T,class TLess>
+   static void       SortInsertion(T *begin,T *end,TLess &less);
+   template <class T,class TLess>
+   static void       SortInsertionUnguarded(T *begin,T *end,TLess &less);
+   template <class T,class TLess>
+   static bool       SortInsertionPartial(T *begin,T *end,TLess &less);
+   template <class T,class TLess>
+   static void       Sort2(T *a,T *b,TLess &less);
+   template <class T,class TLess>
+   static void       Sort3(T *a,T *b,T *c,TLess &less);
+   template <class T,class TLess>
+   static T*         PartitionRight(T *begin,T *end,TLess &less,bool &partitioned);
+   template <class T,class TLess>
+   static T*         PartitionRightBlock(T *begin,T *end,TLess &less,bool &partitioned);
+   template <class T,class TLess>
+   static T*         PartitionLeft(T *begin,T *end,TLess &less);
+   template <class T>
+   static void       SwapOffsets(T *first,T *last,const uint8_t *offsets_l,const uint8_t *offsets_r,size_t num,bool use_swaps);
+   //--- CRT quick sort
    template <class T>
    static void       ShortSort (T *lo,T *hi,SortFunctionPtr compare);
    template <class T>
@@ -401,3 +447,501 @@ inline void* SMTSearch::SearchRight(const void *key,void *base,size_t total,cons
    return(NULL);
   }
 //+------------------------------------------------------------------+
+//| Pattern-defeating quick sort                                     |
+//| https://github.com/orlp/pdqsort                                  |
+//| introsort with median of 3/pseudomedian of 9 pivot, detection    |
+//| of sorted runs and heap sort fallback on bad partitions,         |
+//| trivially copyable records are partitioned branchless by blocks  |
+//+------------------------------------------------------------------+
+template <class T,class TLess>
+inline void SMTSearch::Sort(T *base,size_t total,TLess less)
+  {
+   int bad_allowed=0;
+//--- check
+   if(base==NULL || total<2) return;
+//--- log2 of size bad partitions are allowed before heap sort
+   for(size_t i=total; i>1; i>>=1)
+      bad_allowed++;
+//--- sort
+   SortLoop(base,base+total,less,bad_allowed,true);
+  }
+//+------------------------------------------------------------------+
+//| Sorting loop, the left part is recursive, the right is iterative |
+//+------------------------------------------------------------------+
+template <class T,class TLess>
+inline void SMTSearch::SortLoop(T *begin,T *end,TLess &less,int bad_allowed,bool leftmost)
+  {
+   bool partitioned;
+   T   *pivot;
+//---
+   for(;;)
+     {
+      size_t size=size_t(end-begin);
+      //--- insertion sort for small ranges
+      if(size<SORT_INSERTION_THRESHOLD)
+        {
+         if(leftmost) SortInsertion(begin,end,less);
+         else         SortInsertionUnguarded(begin,end,less);
+         return;
+        }
+      //--- pivot as median of 3 or pseudomedian of 9
+      size_t half=size/2;
+      if(size>SORT_NINTHER_THRESHOLD)
+        {
+         Sort3(begin,begin+half,end-1,less);
+         Sort3(begin+1,begin+(half-1),end-2,less);
+         Sort3(begin+2,begin+(half+1),end-3,less);
+         Sort3(begin+(half-1),begin+half,begin+(half+1),less);
+         std::swap(*begin,*(begin+half));
+        }
+      else
+         Sort3(begin+half,begin,end-1,less);
+      //--- the previous element is the pivot of the parent partition and is not less than any
+      //--- element here, if it is equal to the pivot, put all equal elements to the left and skip them
+      if(!leftmost && !less(*(begin-1),*begin))
+        {
+         begin=PartitionLeft(begin,end,less)+1;
+         continue;
+        }
+      //--- partition
+      if(std::is_trivially_copyable<T>::value)
+         pivot=PartitionRightBlock(begin,end,less,partitioned);
+      else
+         pivot=PartitionRight(begin,end,less,partitioned);
+      //--- check for a highly unbalanced partition
+      size_t l_size=size_t(pivot-begin);
+      size_t r_size=size_t(end-(pivot+1));
+      if(l_size<size/8 || r_size<size/8)
+        {
+         //--- too many bad partitions, switch to heap sort to guarantee O(n log n)
+         if(--bad_allowed==0)
+           {
+            std::make_heap(begin,end,less);
+            std::sort_heap(begin,end,less);
+            return;
+           }
+         //--- shuffle elements to break patterns
+         if(l_size>=SORT_INSERTION_THRESHOLD)
+           {
+            std::swap(*begin,*(begin+l_size/4));
+            std::swap(*(pivot-1),*(pivot-l_size/4));
+            if(l_size>SORT_NINTHER_THRESHOLD)
+              {
+               std::swap(*(begin+1),*(begin+(l_size/4+1)));
+               std::swap(*(begin+2),*(begin+(l_size/4+2)));
+               std::swap(*(pivot-2),*(pivot-(l_size/4+1)));
+               std::swap(*(pivot-3),*(pivot-(l_size/4+2)));
+              }
+           }
+         if(r_size>=SORT_INSERTION_THRESHOLD)
+           {
+            std::swap(*(pivot+1),*(pivot+(1+r_size/4)));
+            std::swap(*(end-1),*(end-r_size/4));
+            if(r_size>SORT_NINTHER_THRESHOLD)
+              {
+               std::swap(*(pivot+2),*(pivot+(2+r_size/4)));
+               std::swap(*(pivot+3),*(pivot+(3+r_size/4)));
+               std::swap(*(end-2),*(end-(1+r_size/4)));
+               std::swap(*(end-3),*(end-(2+r_size/4)));
+              }
+           }
+        }
+      else
+        {
+         //--- balanced and already partitioned, try to finish with insertion sort
+         if(partitioned && SortInsertionPartial(begin,pivot,less) && SortInsertionPartial(pivot+1,end,less))
+            return;
+        }
+      //--- recursion for the left part, iteration for the right one
+      SortLoop(begin,pivot,less,bad_allowed,leftmost);
+      begin   =pivot+1;
+      leftmost=false;
+     }
+  }
+//+------------------------------------------------------------------+
+//| Insertion sort                                                   |
+//+------------------------------------------------------------------+
+template <class T,class TLess>
+inline void SMTSearch::SortInsertion(T *begin,T *end,TLess &less)
+  {
+   if(begin==end) return;
+//---
+   for(T *cur=begin+1; cur!=end; cur++)
+     {
+      T *sift=cur,*sift_1=cur-1;
+      if(less(*sift,*sift_1))
+        {
+         T tmp(std::move(*sift));
+         do
+           {
+            *sift--=std::move(*sift_1);
+           }
+         while(sift!=begin && less(tmp,*--sift_1));
+         *sift=std::move(tmp);
+        }
+     }
+  }
+//+------------------------------------------------------------------+
+//| Insertion sort, the element before begin is not greater than any |
+//| element of the range and is used as a sentinel                   |
+//+------------------------------------------------------------------+
+template <class T,class TLess>
+inline void SMTSearch::SortInsertionUnguarded(T *begin,T *end,TLess &less)
+  {
+   if(begin==end) return;
+//---
+   for(T *cur=begin+1; cur!=end; cur++)
+     {
+      T *sift=cur,*sift_1=cur-1;
+      if(less(*sift,*sift_1))
+        {
+         T tmp(std::move(*sift));
+         do
+           {
+            *sift--=std::move(*sift_1);
+           }
+         while(less(tmp,*--sift_1));
+         *sift=std::move(tmp);
+        }
+     }
+  }
+//+------------------------------------------------------------------+
+//| Insertion sort with limited number of moves                      |
+//| Returns false if the limit is exceeded                           |
+//+------------------------------------------------------------------+
+template <class T,class TLess>
+inline bool SMTSearch::SortInsertionPartial(T *begin,T *end,TLess &less)
+  {
+   size_t limit=0;
+//---
+   if(begin==end) return(true);
+//---
+   for(T *cur=begin+1; cur!=end; cur++)
+     {
+      T *sift=cur,*sift_1=cur-1;
+      if(less(*sift,*sift_1))
+        {
+         T tmp(std::move(*sift));
+         do
+           {
+            *sift--=std::move(*sift_1);
+           }
+         while(sift!=begin && less(tmp,*--sift_1));
+         *sift=std::move(tmp);
+         limit+=size_t(cur-sift);
+        }
+      if(limit>SORT_PARTIAL_LIMIT)
+         return(false);
+     }
+//---
+   return(true);
+  }
+//+------------------------------------------------------------------+
+//| Sort 2 and 3 elements                                            |
+//+------------------------------------------------------------------+
+template <class T,class TLess>
+inline void SMTSearch::Sort2(T *a,T *b,TLess &less)
+  {
+   if(less(*b,*a)) std::swap(*a,*b);
+  }
+template <class T,class TLess>
+inline void SMTSearch::Sort3(T *a,T *b,T *c,TLess &less)
+  {
+   Sort2(a,b,less);
+   Sort2(b,c,less);
+   Sort2(a,b,less);
+  }
+//+------------------------------------------------------------------+
+//| Partition around the pivot *begin, elements equal to the pivot   |
+//| go to the right part, returns the pivot position                 |
+//+------------------------------------------------------------------+
+template <class T,class TLess>
+inline T* SMTSearch::PartitionRight(T *begin,T *end,TLess &less,bool &partitioned)
+  {
+   T  pivot(std::move(*begin));
+   T *first=begin,*last=end;
+//--- first element not less than the pivot, the median guarantees it exists
+   while(less(*++first,pivot));
+//--- last element less than the pivot, guarded if there was nothing before first
+   if(first-1==begin) while(first<last && !less(*--last,pivot));
+   else               while(!less(*--last,pivot));
+//--- the first pair to swap is the same element, the range is already partitioned
+   partitioned=first>=last;
+//--- swap wrong elements
+   while(first<last)
+     {
+      std::swap(*first,*last);
+      while(less(*++first,pivot));
+      while(!less(*--last,pivot));
+     }
+//--- put the pivot in place
+   T *pivot_pos=first-1;
+   *begin    =std::move(*pivot_pos);
+   *pivot_pos=std::move(pivot);
+   return(pivot_pos);
+  }
+//+------------------------------------------------------------------+
+//| Branchless block partition, see "BlockQuicksort: How Branch      |
+//| Mispredictions don't affect Quicksort" by Edelkamp and Weiss     |
+//+------------------------------------------------------------------+
+template <class T,class TLess>
+inline T* SMTSearch::PartitionRightBlock(T *begin,T *end,TLess &less,bool &partitioned)
+  {
+   T  pivot(std::move(*begin));
+   T *first=begin,*last=end;
+//--- first element not less than the pivot, the median guarantees it exists
+   while(less(*++first,pivot));
+//--- last element less than the pivot, guarded if there was nothing before first
+   if(first-1==begin) while(first<last && !less(*--last,pivot));
+   else               while(!less(*--last,pivot));
+//--- the first pair to swap is the same element, the range is already partitioned
+   partitioned=first>=last;
+   if(!partitioned)
+     {
+      alignas(64) uint8_t offsets_l[SORT_BLOCK_SIZE];
+      alignas(64) uint8_t offsets_r[SORT_BLOCK_SIZE];
+      T                  *offsets_l_base,*offsets_r_base;
+      size_t              num_l=0,num_r=0,start_l=0,start_r=0;
+      //---
+      std::swap(*first,*last);
+      first++;
+      offsets_l_base=first;
+      offsets_r_base=last;
+      //---
+      while(first<last)
+        {
+         //--- elements to check for each side
+         size_t num_unknown=size_t(last-first);
+         size_t left_split =num_l==0 ? (num_r==0 ? num_unknown/2 : num_unknown) : 0;
+         size_t right_split=num_r==0 ? (num_unknown-left_split) : 0;
+         if(left_split>SORT_BLOCK_SIZE)
+            left_split=SORT_BLOCK_SIZE;
+         if(right_split>SORT_BLOCK_SIZE)
+            right_split=SORT_BLOCK_SIZE;
+         //--- collect offsets of the elements on the wrong side without branches
+         for(size_t i=0; i<left_split; i++)
+           {
+            offsets_l[num_l]=uint8_t(i);
+            num_l+=!less(*first,pivot);
+            first++;
+           }
+         for(size_t i=0; i<right_split;)
+           {
+            offsets_r[num_r]=uint8_t(++i);
+            num_r+=less(*--last,pivot);
+           }
+         //--- swap pairs
+         size_t num=num_l<num_r ? num_l : num_r;
+         SwapOffsets(offsets_l_base,offsets_r_base,offsets_l+start_l,offsets_r+start_r,num,num_l==num_r);
+         num_l  -=num;
+         num_r  -=num;
+         start_l+=num;
+         start_r+=num;
+         //--- the side is done, start new block
+         if(num_l==0)
+           {
+            start_l       =0;
+            offsets_l_base=first;
+           }
+         if(num_r==0)
+           {
+            start_r       =0;
+            offsets_r_base=last;
+           }
+        }
+      //--- the remaining elements of one side
+      if(num_l)
+        {
+         while(num_l--)
+            std::swap(*(offsets_l_base+offsets_l[start_l+num_l]),*--last);
+         first=last;
+        }
+      if(num_r)
+        {
+         while(num_r--)
+           {
+            std::swap(*(offsets_r_base-offsets_r[start_r+num_r]),*first);
+            first++;
+           }
+         last=first;
+        }
+     }
+//--- put the pivot in place
+   T *pivot_pos=first-1;
+   *begin    =std::move(*pivot_pos);
+   *pivot_pos=std::move(pivot);
+   return(pivot_pos);
+  }
+//+------------------------------------------------------------------+
+//| Swap elements by offsets, cyclic permutation when possible       |
+//+------------------------------------------------------------------+
+template <class T>
+inline void SMTSearch::SwapOffsets(T *first,T *last,const uint8_t *offsets_l,const uint8_t *offsets_r,size_t num,bool use_swaps)
+  {
+//--- swaps are needed for the descending sequences to remain O(n)
+   if(use_swaps)
+     {
+      for(size_t i=0; i<num; i++)
+         std::swap(*(first+offsets_l[i]),*(last-offsets_r[i]));
+     }
+   else
+      if(num>0)
+        {
+         T *l=first+offsets_l[0],*r=last-offsets_r[0];
+         T  tmp(std::move(*l));
+         *l=std::move(*r);
+         for(size_t i=1; i<num; i++)
+           {
+            l =first+offsets_l[i];
+            *r=std::move(*l);
+            r =last-offsets_r[i];
+            *l=std::move(*r);
+           }
+         *r=std::move(tmp);
+        }
+  }
+//+------------------------------------------------------------------+
+//| Partition around the pivot *begin, elements equal to the pivot   |
+//| go to the left part, returns the pivot position                  |
+//+------------------------------------------------------------------+
+template <class T,class TLess>
+inline T* SMTSearch::PartitionLeft(T *begin,T *end,TLess &less)
+  {
+   T  pivot(std::move(*begin));
+   T *first=begin,*last=end;
+//---
+   while(less(pivot,*--last));
+   if(last+1==end) while(first<last && !less(pivot,*++first));
+   else            while(!less(pivot,*++first));
+//---
+   while(first<last)
+     {
+      std::swap(*first,*last);
+      while(less(pivot,*--last));
+      while(!less(pivot,*++first));
+     }
+//--- put the pivot in place
+   T *pivot_pos=last;
+   *begin    =std::move(*pivot_pos);
+   *pivot_pos=std::move(pivot);
+   return(pivot_pos);
+  }
+//+------------------------------------------------------------------+
+//| First record with key not less than key value                    |
+//| Returns base+total if there is no such record                    |
+//+------------------------------------------------------------------+
+template <class T,class TKey,class TKeyFn>
+inline T* SMTSearch::LowerBound(T *base,size_t total,const TKey &key,TKeyFn key_fn)
+  {
+//--- check
+   if(base==NULL || total<1) return(base);
+//--- halve the range without branches, the compiler uses cmov
+   while(total>1)
+     {
+      size_t half=total/2;
+      base =(key_fn(base[half])<key) ? base+half : base;
+      total-=half;
+     }
+//---
+   return(base+(key_fn(*base)<key));
+  }
+//+------------------------------------------------------------------+
+//| First record with key greater than key value                     |
+//| Returns base+total if there is no such record                    |
+//+------------------------------------------------------------------+
+template <class T,class TKey,class TKeyFn>
+inline T* SMTSearch::UpperBound(T *base,size_t total,const TKey &key,TKeyFn key_fn)
+  {
+//--- check
+   if(base==NULL || total<1) return(base);
+//--- halve the range without branches, the compiler uses cmov
+   while(total>1)
+     {
+      size_t half=total/2;
+      base =(key<key_fn(base[half])) ? base : base+half;
+      total-=half;
+     }
+//---
+   return(base+!(key<key_fn(*base)));
+  }
+//+------------------------------------------------------------------+
+//| Stable LSD radix sort                                            |
+//| histograms of all digits are built in one pass, passes where all |
+//| keys have the same digit are skipped, records are moved between  |
+//| the array and a temporary buffer of the same size                |
+//+------------------------------------------------------------------+
+template <uint32_t TDigitBits,class T,class TKeyFn>
+inline void SMTSearch::RadixSort(T *base,size_t total,TKeyFn key_fn)
+  {
+   typedef typename std::decay<decltype(key_fn(*base))>::type TKey;
+//--- check types
+   static_assert(TDigitBits==8 || TDigitBits==11 || TDigitBits==16,"Radix sort digit must be 8, 11 or 16 bits");
+   static_assert(std::is_integral<TKey>::value && sizeof(TKey)<=sizeof(uint64_t),"Radix sort key must be integer");
+   static_assert(std::is_trivially_copyable<T>::value,"Radix sort is for POD records only");
+//--- digits
+   const uint32_t digits=(sizeof(TKey)*8+TDigitBits-1)/TDigitBits;
+   const size_t   radix =size_t(1)<<TDigitBits;
+   const uint64_t mask  =radix-1;
+//--- signed keys are ordered as unsigned with inverted sign bit
+   const uint64_t flip  =std::is_signed<TKey>::value ? (uint64_t(1)<<(sizeof(TKey)*8-1)) : 0;
+   const uint64_t width =sizeof(TKey)<sizeof(uint64_t) ? ((uint64_t(1)<<(sizeof(TKey)*8))-1) : ~uint64_t(0);
+   auto           key   =[&key_fn,flip,width](const T &rec) { return((uint64_t(key_fn(rec)) & width)^flip); };
+//--- check
+   if(base==NULL || total<2)
+      return;
+//--- comparison sort for small arrays
+   if(total<SORT_RADIX_THRESHOLD)
+     {
+      std::stable_sort(base,base+total,[&key](const T &l,const T &r) { return(key(l)<key(r)); });
+      return;
+     }
+//--- allocate histograms and temporary buffer
+   size_t *counts=new(std::nothrow) size_t[radix*digits];
+   T      *temp  =(T*)::operator new(sizeof(T)*total,std::nothrow);
+   if(counts==NULL || temp==NULL)
+     {
+      if(counts) delete[] counts;
+      if(temp)   ::operator delete(temp);
+      std::stable_sort(base,base+total,[&key](const T &l,const T &r) { return(key(l)<key(r)); });
+      return;
+     }
+//--- histograms of all digits at once
+   memset(counts,0,sizeof(size_t)*radix*digits);
+   for(size_t i=0; i<total; i++)
+     {
+      uint64_t k=key(base[i]);
+      for(uint32_t d=0; d<digits; d++)
+         counts[d*radix+((k>>(d*TDigitBits)) & mask)]++;
+     }
+//--- distribute by digits from the lowest
+   T *src=base,*dst=temp;
+   for(uint32_t d=0; d<digits; d++)
+     {
+      size_t  *offsets=counts+d*radix;
+      uint32_t shift  =d*TDigitBits;
+      //--- all keys have the same digit, skip the pass
+      if(offsets[(key(*src)>>shift) & mask]==total)
+         continue;
+      //--- counts to offsets
+      for(size_t r=0,sum=0; r<radix; r++)
+        {
+         size_t count=offsets[r];
+         offsets[r]=sum;
+         sum      +=count;
+        }
+      //--- stable distribution
+      for(size_t i=0; i<total; i++)
+         dst[offsets[(key(src[i])>>shift) & mask]++]=src[i];
+      //--- swap buffers
+      T *tmp=src;
+      src=dst;
+      dst=tmp;
+     }
+//--- result is in the temporary buffer
+   if(src!=base)
+      memcpy((void*)base,(const void*)src,sizeof(T)*total);
+//--- free
+   delete[] counts;
+   ::operator delete(temp);
+  }
+//+------------------------------------------------------------------+
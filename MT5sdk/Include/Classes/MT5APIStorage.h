@@ -7,10 +7,35 @@
 #include <new.h>
 #include <stdlib.h>
 #include <utility>
+#include <type_traits>
 #include "MT5APISearch.h"
+#include "MT5APIArena.h"
+//+------------------------------------------------------------------+
+//| Growth policies of dynamic arrays                                |
+//+------------------------------------------------------------------+
+//--- linear growth by step records
+struct MTArrayGrowLinear
+  {
+   static const bool     GEOMETRIC=false;    // grow by half of the allocated size
+   static const uint32_t CAP      =0;        // maximum growth in records, 0 - unlimited
+  };
+//--- geometric growth
+struct MTArrayGrowGeometric
+  {
+   static const bool     GEOMETRIC=true;
+   static const uint32_t CAP      =0;
+  };
+//--- geometric growth, but not more than cap records at once
+template <uint32_t cap> struct MTArrayGrowGeometricCap
+  {
+   static const bool     GEOMETRIC=true;
+   static const uint32_t CAP      =cap;
+  };
 //+------------------------------------------------------------------+
 //| Dynamic array base class                                         |
 //| For POD data types only!                                         |
+//| memory is taken from the heap or from the bound arena, array     |
+//| bound to arena must be shut down before the arena Reset/Rewind   |
 //+------------------------------------------------------------------+
 class CMTArrayBase
   {
@@ -20,15 +45,21 @@ protected:
    uint32_t          m_data_max;         // array records max
    uint32_t          m_data_width;       // record size in bytes
    uint32_t          m_data_step;        // reallocation step
+   bool              m_data_geometric;   // geometric growth
+   uint32_t          m_data_cap;         // maximum growth in records for geometric growth, 0 - unlimited
+   CMTArena         *m_arena;            // memory arena, NULL - heap
 
 public:
-                     CMTArrayBase(const uint32_t width,const uint32_t step);
+                     CMTArrayBase(const uint32_t width,const uint32_t step,const bool geometric=false,const uint32_t cap=0);
    virtual          ~CMTArrayBase();
    //--- common properties
    uint32_t          Total(void) const                        { return(m_data_total);      }
    uint32_t          Width(void) const                        { return(m_data_width);      }
    uint32_t          Max(void) const                          { return(m_data_max);        }
    uint32_t          Step(void) const                         { return(m_data_step);       }
+   //--- memory arena, can be changed for the empty array only
+   CMTArena*         Arena(void) const                        { return(m_arena);           }
+   bool              Arena(CMTArena *arena);
    bool              Compare(const CMTArrayBase& array) const;
    //--- global management
    void              Clear(void)                              { m_data_total=0;            }
@@ -78,14 +109,15 @@ public:
    void*             SearchRight(const void *key,SMTSearch::SortFunctionPtr sort_function) const;
 
 protected:
-                     CMTArrayBase(void):m_data(NULL),m_data_total(0),m_data_max(0),m_data_width(0),m_data_step(0){}
+                     CMTArrayBase(void):m_data(NULL),m_data_total(0),m_data_max(0),m_data_width(0),m_data_step(0),m_data_geometric(false),m_data_cap(0),m_arena(NULL){}
    bool              Realloc(const uint32_t total);
   };
 //+------------------------------------------------------------------+
 //|                                                                  |
 //+------------------------------------------------------------------+
-inline CMTArrayBase::CMTArrayBase(const uint32_t width,const uint32_t step) : m_data(NULL),m_data_total(0),
-                                                                  m_data_max(0),m_data_width(width),m_data_step(step)
+inline CMTArrayBase::CMTArrayBase(const uint32_t width,const uint32_t step,const bool geometric,const uint32_t cap) : m_data(NULL),m_data_total(0),
+                                                                  m_data_max(0),m_data_width(width),m_data_step(step),
+                                                                  m_data_geometric(geometric),m_data_cap(cap),m_arena(NULL)
   {
   }
 //+------------------------------------------------------------------+
@@ -96,6 +128,18 @@ inline CMTArrayBase::~CMTArrayBase(void)
    Shutdown();
   }
 //+------------------------------------------------------------------+
+//| Bind array to arena, NULL - to heap                              |
+//+------------------------------------------------------------------+
+inline bool CMTArrayBase::Arena(CMTArena *arena)
+  {
+//--- allocated memory can not be moved between allocators
+   if(m_data)
+      return(arena==m_arena);
+//--- bind
+   m_arena=arena;
+   return(true);
+  }
+//+------------------------------------------------------------------+
 //| Zero all elements                                                |
 //+------------------------------------------------------------------+
 inline bool CMTArrayBase::Zero(void)
@@ -108,8 +152,15 @@ inline bool CMTArrayBase::Zero(void)
 //+------------------------------------------------------------------+
 inline void CMTArrayBase::Shutdown(void)
   {
-//--- clear all
-   if(m_data) { delete[] m_data; m_data=NULL; }
+//--- clear all, arena frees memory by itself
+   if(m_data)
+     {
+      if(m_arena)
+         m_arena->Free(m_data,size_t(m_data_max)*m_data_width);
+      else
+         delete[] m_data;
+      m_data=NULL;
+     }
 //--- zero sizes
    m_data_total=m_data_max=0;
   }
@@ -144,8 +195,26 @@ inline bool CMTArrayBase::Realloc(const uint32_t total)
    if(m_data && (m_data_total+total)<=m_data_max) return(true);
 //--- calculate reallocation
    uint32_t add=((total/m_data_step)+1)*m_data_step;
+//--- geometric growth by half of the allocated size, limited by cap
+   if(m_data_geometric)
+     {
+      uint32_t grow=m_data_max/2;
+      if(m_data_cap && grow>m_data_cap)
+         grow=m_data_cap;
+      if(grow>add && uint64_t(m_data_max)+grow<=0xFFFFFFFF)
+         add=grow;
+     }
+//--- arena grows the last allocation in place
+   if(m_arena)
+     {
+      uint8_t *buffer=(uint8_t*)m_arena->Reallocate(m_data,size_t(m_data_max)*m_data_width,size_t(m_data_max+add)*m_data_width);
+      if(!buffer) return(false);
+      m_data     =buffer;
+      m_data_max+=add;
+      return(true);
+     }
 //--- allocate new buffer
-   uint8_t *buffer=new(std::nothrow) uint8_t[(m_data_max+add)*m_data_width];
+   uint8_t *buffer=new(std::nothrow) uint8_t[size_t(m_data_max+add)*m_data_width];
 //--- check
    if(!buffer) return(false);
 //--- previous data?
@@ -169,6 +238,13 @@ inline void CMTArrayBase::Compact(void)
    uint8_t *newdata;
 //--- check
    if(!m_data || freespace<=m_data_step) return;
+//--- arena shrinks in place
+   if(m_arena)
+     {
+      m_arena->Reallocate(m_data,size_t(m_data_max)*m_data_width,size_t(m_data_total+m_data_step)*m_data_width);
+      m_data_max=m_data_total+m_data_step;
+      return;
+     }
 //--- allocate new block
    newdata=new(std::nothrow) uint8_t[(m_data_total+m_data_step)*m_data_width];
 //--- check memory
@@ -205,6 +281,7 @@ inline void CMTArrayBase::Swap(CMTArrayBase &arr)
    uint8_t *data;
    uint32_t   data_total;
    uint32_t   data_max;
+   CMTArena  *arena;
 //--- check
    if(this==&arr) return;
 //--- check width
@@ -213,12 +290,15 @@ inline void CMTArrayBase::Swap(CMTArrayBase &arr)
    data      =m_data;
    data_total=m_data_total;
    data_max  =m_data_max;
+   arena     =m_arena;
    m_data      =arr.m_data;
    m_data_total=arr.m_data_total;
    m_data_max  =arr.m_data_max;
+   m_arena     =arr.m_arena;
    arr.m_data      =data;
    arr.m_data_total=data_total;
    arr.m_data_max  =data_max;
+   arr.m_arena     =arena;
   }
 //+------------------------------------------------------------------+
 //| Reserve free space                                               |
@@ -626,20 +706,21 @@ inline void* CMTArrayBase::SearchRight(const void *key,SMTSearch::SortFunctionPt
 //| Dynamic array template                                           |
 //| For POD data types only!                                         |
 //+------------------------------------------------------------------+
-template <class T,uint32_t step=16> class TMTArray : public CMTArrayBase
+template <class T,uint32_t step=16,class TGrowth=MTArrayGrowLinear> class TMTArray : public CMTArrayBase
   {
 public:
-                     TMTArray() : CMTArrayBase(sizeof(T),step)            {}
+                     TMTArray() : CMTArrayBase(sizeof(T),step,TGrowth::GEOMETRIC,TGrowth::CAP) {}
+   explicit          TMTArray(CMTArena *arena) : CMTArrayBase(sizeof(T),step,TGrowth::GEOMETRIC,TGrowth::CAP) { m_arena=arena; }
    virtual          ~TMTArray(){}
    //--- global management
-   void              Swap(TMTArray<T,step> &arr)                          { CMTArrayBase::Swap(arr);                     }
+   void              Swap(TMTArray<T,step,TGrowth> &arr)                          { CMTArrayBase::Swap(arr);                     }
    //--- add
    bool              Add(const T *elem)                                   { return CMTArrayBase::Add(elem);              }
    bool              Add(const T *elem,const uint32_t total)                  { return CMTArrayBase::Add(elem,total);        }
-   bool              Add(const TMTArray<T,step>& arr)                     { return CMTArrayBase::Add(arr);               }
+   bool              Add(const TMTArray<T,step,TGrowth>& arr)                     { return CMTArrayBase::Add(arr);               }
    template <typename... TArgs>
    T*                AddEmplace(TArgs&&... args);
-   bool              AddRange(const TMTArray<T,step>& arr,const uint32_t from,const uint32_t to)
+   bool              AddRange(const TMTArray<T,step,TGrowth>& arr,const uint32_t from,const uint32_t to)
    { return CMTArrayBase::AddRange(arr,from,to);  }
    T*                Append(void)                                         { return(T*)CMTArrayBase::Append();            }
    bool              Insert(const uint32_t pos,const T *elem)                 { return CMTArrayBase::Insert(pos,elem);       }
@@ -666,12 +747,32 @@ public:
    T*                SearchLess(const void *key,SMTSearch::SortFunctionPtr sort_function)      const  { return(T*)CMTArrayBase::SearchLess(key,sort_function);      }
    T*                SearchLeft(const void *key,SMTSearch::SortFunctionPtr sort_function)      const  { return(T*)CMTArrayBase::SearchLeft(key,sort_function);      }
    T*                SearchRight(const void *key,SMTSearch::SortFunctionPtr sort_function)     const  { return(T*)CMTArrayBase::SearchRight(key,sort_function);     }
+   //--- sort & search with inlined comparator less(a,b) or key extractor key_fn(record)
+   using             CMTArrayBase::Sort;
+   template <class TLess,class=typename std::enable_if<!std::is_convertible<TLess,SMTSearch::SortFunctionPtr>::value>::type>
+   void              Sort(TLess less)                                     { SMTSearch::Sort((T*)m_data,m_data_total,less); }
+   template <class TKeyFn>
+   void              SortByKey(TKeyFn key_fn)                             { SMTSearch::Sort((T*)m_data,m_data_total,[&key_fn](const T &l,const T &r) { return(key_fn(l)<key_fn(r)); }); }
+   template <class TKey,class TKeyFn,class=typename std::enable_if<!std::is_convertible<TKeyFn,SMTSearch::SortFunctionPtr>::value>::type>
+   T*                Search(const TKey &key,TKeyFn key_fn) const          { return(SearchLeft(key,key_fn));              }
+   template <class TKey,class TKeyFn,class=typename std::enable_if<!std::is_convertible<TKeyFn,SMTSearch::SortFunctionPtr>::value>::type>
+   T*                SearchGreatOrEq(const TKey &key,TKeyFn key_fn) const;
+   template <class TKey,class TKeyFn,class=typename std::enable_if<!std::is_convertible<TKeyFn,SMTSearch::SortFunctionPtr>::value>::type>
+   T*                SearchGreater(const TKey &key,TKeyFn key_fn) const;
+   template <class TKey,class TKeyFn,class=typename std::enable_if<!std::is_convertible<TKeyFn,SMTSearch::SortFunctionPtr>::value>::type>
+   T*                SearchLessOrEq(const TKey &key,TKeyFn key_fn) const;
+   template <class TKey,class TKeyFn,class=typename std::enable_if<!std::is_convertible<TKeyFn,SMTSearch::SortFunctionPtr>::value>::type>
+   T*                SearchLess(const TKey &key,TKeyFn key_fn) const;
+   template <class TKey,class TKeyFn,class=typename std::enable_if<!std::is_convertible<TKeyFn,SMTSearch::SortFunctionPtr>::value>::type>
+   T*                SearchLeft(const TKey &key,TKeyFn key_fn) const;
+   template <class TKey,class TKeyFn,class=typename std::enable_if<!std::is_convertible<TKeyFn,SMTSearch::SortFunctionPtr>::value>::type>
+   T*                SearchRight(const TKey &key,TKeyFn key_fn) const;
    //--- operators
    const T&          operator[](const uint32_t pos) const                     { return(*(T*)CMTArrayBase::At(pos));          }
    T&                operator[](const uint32_t pos)                           { return(*(T*)CMTArrayBase::At(pos));          }
-   bool              operator==(const TMTArray<T,step>& arr) const        { return(CMTArrayBase::Compare(arr));          }
-   bool              operator!=(const TMTArray<T,step>& arr) const        { return(!CMTArrayBase::Compare(arr));         }
-   TMTArray<T,step>& operator= (const TMTArray<T,step>& arr)              { if(this!=&arr) Assign(arr); return(*this);   }
+   bool              operator==(const TMTArray<T,step,TGrowth>& arr) const        { return(CMTArrayBase::Compare(arr));          }
+   bool              operator!=(const TMTArray<T,step,TGrowth>& arr) const        { return(!CMTArrayBase::Compare(arr));         }
+   TMTArray<T,step,TGrowth>& operator= (const TMTArray<T,step,TGrowth>& arr)              { if(this!=&arr) Assign(arr); return(*this);   }
    //--- C++ iteration
    T*                begin(void)                                          { return(CMTArrayBase::m_data_total ? ((T*)CMTArrayBase::m_data) : nullptr);       }
    const T*          begin(void) const                                    { return(CMTArrayBase::m_data_total ? ((const T*)CMTArrayBase::m_data) : nullptr); }
@@ -682,6 +783,68 @@ private:
                      TMTArray(const TMTArray&) {};
   };
 //+------------------------------------------------------------------+
+//| Search great or equal than key value on sorted array             |
+//+------------------------------------------------------------------+
+template <class T,uint32_t step,class TGrowth>
+template <class TKey,class TKeyFn,class>
+inline T* TMTArray<T,step,TGrowth>::SearchGreatOrEq(const TKey &key,TKeyFn key_fn) const
+  {
+   T *end=(T*)m_data+m_data_total;
+   T *res=SMTSearch::LowerBound((T*)m_data,m_data_total,key,key_fn);
+   return(res!=end ? res : NULL);
+  }
+//+------------------------------------------------------------------+
+//| Search great than key value on sorted array                      |
+//+------------------------------------------------------------------+
+template <class T,uint32_t step,class TGrowth>
+template <class TKey,class TKeyFn,class>
+inline T* TMTArray<T,step,TGrowth>::SearchGreater(const TKey &key,TKeyFn key_fn) const
+  {
+   T *end=(T*)m_data+m_data_total;
+   T *res=SMTSearch::UpperBound((T*)m_data,m_data_total,key,key_fn);
+   return(res!=end ? res : NULL);
+  }
+//+------------------------------------------------------------------+
+//| Search less or equal than key value on sorted array              |
+//+------------------------------------------------------------------+
+template <class T,uint32_t step,class TGrowth>
+template <class TKey,class TKeyFn,class>
+inline T* TMTArray<T,step,TGrowth>::SearchLessOrEq(const TKey &key,TKeyFn key_fn) const
+  {
+   T *res=SMTSearch::UpperBound((T*)m_data,m_data_total,key,key_fn);
+   return(res!=(T*)m_data ? res-1 : NULL);
+  }
+//+------------------------------------------------------------------+
+//| Search less than key value on sorted array                       |
+//+------------------------------------------------------------------+
+template <class T,uint32_t step,class TGrowth>
+template <class TKey,class TKeyFn,class>
+inline T* TMTArray<T,step,TGrowth>::SearchLess(const TKey &key,TKeyFn key_fn) const
+  {
+   T *res=SMTSearch::LowerBound((T*)m_data,m_data_total,key,key_fn);
+   return(res!=(T*)m_data ? res-1 : NULL);
+  }
+//+------------------------------------------------------------------+
+//| Search first element with key equal to key value on sorted array |
+//+------------------------------------------------------------------+
+template <class T,uint32_t step,class TGrowth>
+template <class TKey,class TKeyFn,class>
+inline T* TMTArray<T,step,TGrowth>::SearchLeft(const TKey &key,TKeyFn key_fn) const
+  {
+   T *res=SearchGreatOrEq(key,key_fn);
+   return(res && !(key<key_fn(*res)) ? res : NULL);
+  }
+//+------------------------------------------------------------------+
+//| Search last element with key equal to key value on sorted array  |
+//+------------------------------------------------------------------+
+template <class T,uint32_t step,class TGrowth>
+template <class TKey,class TKeyFn,class>
+inline T* TMTArray<T,step,TGrowth>::SearchRight(const TKey &key,TKeyFn key_fn) const
+  {
+   T *res=SearchLessOrEq(key,key_fn);
+   return(res && !(key_fn(*res)<key) ? res : NULL);
+  }
+//+------------------------------------------------------------------+
 //| Predefined arrays                                                |
 //+------------------------------------------------------------------+
 typedef TMTArray<uint8_t>   MTByteArray;
@@ -697,9 +860,9 @@ typedef TMTArray<double>  MTDoubleArray;
 //| Placement adding an element to the end of the array              |
 //| Returns a pointer to a new element if successful, otherwise 0    |
 //+------------------------------------------------------------------+
-template <typename T,uint32_t step>
+template <typename T,uint32_t step,class TGrowth>
 template <typename... TArgs>
-T* TMTArray<T,step>::AddEmplace(TArgs&&... args)
+T* TMTArray<T,step,TGrowth>::AddEmplace(TArgs&&... args)
   {
 //--- appending an element
    T *ptr=Append();
@@ -709,3 +872,275 @@ T* TMTArray<T,step>::AddEmplace(TArgs&&... args)
    return ptr;
   }
 //+------------------------------------------------------------------+
+//| Dynamic array of objects                                         |
+//| Elements are constructed, moved and destroyed by their own       |
+//| constructors, trivially copyable types are moved by memcpy       |
+//+------------------------------------------------------------------+
+template <class T,uint32_t step=16,class TGrowth=MTArrayGrowGeometric> class TMTVector
+  {
+private:
+   T                *m_data;             // array
+   uint32_t          m_data_total;       // array records total
+   uint32_t          m_data_max;         // array records max
+
+public:
+                     TMTVector(void) : m_data(nullptr),m_data_total(0),m_data_max(0) {}
+                     TMTVector(TMTVector &&arr) : m_data(arr.m_data),m_data_total(arr.m_data_total),m_data_max(arr.m_data_max)
+                       { arr.m_data=nullptr; arr.m_data_total=arr.m_data_max=0; }
+                    ~TMTVector(void)                                      { Shutdown();                                  }
+   //--- common properties
+   uint32_t          Total(void) const                                    { return(m_data_total);                        }
+   uint32_t          Max(void) const                                      { return(m_data_max);                          }
+   //--- global management
+   void              Clear(void);
+   void              Shutdown(void);
+   bool              Reserve(const uint32_t size);
+   bool              Resize(const uint32_t size);
+   void              Swap(TMTVector &arr);
+   //--- add
+   T*                Add(const T &elem)                                   { return(AddEmplace(elem));                    }
+   T*                Add(T &&elem)                                        { return(AddEmplace(std::move(elem)));         }
+   template <typename... TArgs>
+   T*                AddEmplace(TArgs&&... args);
+   T*                Insert(const uint32_t pos,T &&elem);
+   //--- delete
+   bool              Delete(const uint32_t pos);
+   bool              DeleteRange(const uint32_t from,const uint32_t to);
+   //--- data access
+   T*                First(void)                                          { return(m_data_total ? m_data : nullptr);     }
+   T*                Last(void)                                           { return(m_data_total ? m_data+m_data_total-1 : nullptr); }
+   //--- operators
+   const T&          operator[](const uint32_t pos) const                 { return(m_data[pos]);                         }
+   T&                operator[](const uint32_t pos)                       { return(m_data[pos]);                         }
+   TMTVector&        operator=(TMTVector &&arr)                           { if(this!=&arr) { Shutdown(); Swap(arr); } return(*this); }
+   //--- C++ iteration
+   T*                begin(void)                                          { return(m_data);                              }
+   const T*          begin(void) const                                    { return(m_data);                              }
+   T*                end(void)                                            { return(m_data+m_data_total);                 }
+   const T*          end(void) const                                      { return(m_data+m_data_total);                 }
+
+private:
+   bool              Realloc(const uint32_t total);
+   T*                Allocate(const uint32_t total,uint32_t &max) const;
+   void              Replace(T *buffer,const uint32_t max);
+   static void       Relocate(T *dst,T *src,const uint32_t total);
+   //--- prohibit copying
+                     TMTVector(const TMTVector&)=delete;
+   TMTVector&        operator=(const TMTVector&)=delete;
+  };
+//+------------------------------------------------------------------+
+//| Destroy all elements, memory is kept                             |
+//+------------------------------------------------------------------+
+template <class T,uint32_t step,class TGrowth>
+inline void TMTVector<T,step,TGrowth>::Clear(void)
+  {
+   for(uint32_t i=0;i<m_data_total;i++)
+      m_data[i].~T();
+   m_data_total=0;
+  }
+//+------------------------------------------------------------------+
+//| Full shutdown with memory free                                   |
+//+------------------------------------------------------------------+
+template <class T,uint32_t step,class TGrowth>
+inline void TMTVector<T,step,TGrowth>::Shutdown(void)
+  {
+   Clear();
+   if(m_data) { ::operator delete(m_data); m_data=nullptr; }
+   m_data_max=0;
+  }
+//+------------------------------------------------------------------+
+//| Reserve free space                                               |
+//+------------------------------------------------------------------+
+template <class T,uint32_t step,class TGrowth>
+inline bool TMTVector<T,step,TGrowth>::Reserve(const uint32_t size)
+  {
+   if(size<=m_data_max) return(true);
+   else                 return(Realloc(size-m_data_total));
+  }
+//+------------------------------------------------------------------+
+//| Resize array, new elements are value-initialized                 |
+//+------------------------------------------------------------------+
+template <class T,uint32_t step,class TGrowth>
+inline bool TMTVector<T,step,TGrowth>::Resize(const uint32_t size)
+  {
+//--- shrink
+   if(size<m_data_total)
+      return(DeleteRange(size,m_data_total-1));
+//--- grow
+   if(!Reserve(size)) return(false);
+   while(m_data_total<size)
+      new(m_data+m_data_total++) T();
+//--- ok
+   return(true);
+  }
+//+------------------------------------------------------------------+
+//| Swap arrays content                                              |
+//+------------------------------------------------------------------+
+template <class T,uint32_t step,class TGrowth>
+inline void TMTVector<T,step,TGrowth>::Swap(TMTVector &arr)
+  {
+   std::swap(m_data,arr.m_data);
+   std::swap(m_data_total,arr.m_data_total);
+   std::swap(m_data_max,arr.m_data_max);
+  }
+//+------------------------------------------------------------------+
+//| Construct element at the end of the array                        |
+//| Returns a pointer to a new element if successful, otherwise 0    |
+//+------------------------------------------------------------------+
+template <class T,uint32_t step,class TGrowth>
+template <typename... TArgs>
+inline T* TMTVector<T,step,TGrowth>::AddEmplace(TArgs&&... args)
+  {
+   T *ptr;
+//--- construct in place if there is free space
+   if(m_data && m_data_total<m_data_max)
+      ptr=new(m_data+m_data_total) T{std::forward<TArgs>(args)...};
+   else
+     {
+      //--- arguments may refer to our elements, construct in the new buffer before the old one is freed
+      uint32_t max;
+      T       *buffer=Allocate(1,max);
+      if(!buffer) return(nullptr);
+      ptr=new(buffer+m_data_total) T{std::forward<TArgs>(args)...};
+      Replace(buffer,max);
+     }
+   m_data_total++;
+   return(ptr);
+  }
+//+------------------------------------------------------------------+
+//| Insert element into pos position                                 |
+//+------------------------------------------------------------------+
+template <class T,uint32_t step,class TGrowth>
+inline T* TMTVector<T,step,TGrowth>::Insert(const uint32_t pos,T &&elem)
+  {
+   T *ptr;
+//--- check
+   if(pos>m_data_total) return(nullptr);
+//--- no free space, construct in the new buffer and move the old elements around it
+   if(!m_data || m_data_total>=m_data_max)
+     {
+      uint32_t max;
+      T       *buffer=Allocate(1,max);
+      if(!buffer) return(nullptr);
+      ptr=new(buffer+pos) T(std::move(elem));
+      Relocate(buffer,m_data,pos);
+      Relocate(buffer+pos+1,m_data+pos,m_data_total-pos);
+      if(m_data) ::operator delete(m_data);
+      //--- replace
+      m_data    =buffer;
+      m_data_max=max;
+      m_data_total++;
+      return(ptr);
+     }
+//--- element may be one of ours, take it out before the tail is shifted
+   if(&elem>=m_data && &elem<m_data+m_data_total)
+     {
+      T tmp(std::move(elem));
+      return(Insert(pos,std::move(tmp)));
+     }
+//--- shift the tail by one element from the end
+   for(uint32_t i=m_data_total;i>pos;i--)
+     {
+      new(m_data+i) T(std::move(m_data[i-1]));
+      m_data[i-1].~T();
+     }
+//--- insert
+   m_data_total++;
+   return(new(m_data+pos) T(std::move(elem)));
+  }
+//+------------------------------------------------------------------+
+//| Delete record by position                                        |
+//+------------------------------------------------------------------+
+template <class T,uint32_t step,class TGrowth>
+inline bool TMTVector<T,step,TGrowth>::Delete(const uint32_t pos)
+  {
+   return(DeleteRange(pos,pos));
+  }
+//+------------------------------------------------------------------+
+//| Delete range [from,to]                                           |
+//+------------------------------------------------------------------+
+template <class T,uint32_t step,class TGrowth>
+inline bool TMTVector<T,step,TGrowth>::DeleteRange(const uint32_t from,const uint32_t to)
+  {
+//--- check
+   if(from>to || to>=m_data_total) return(false);
+//--- move the tail over the range and destroy the rest
+   uint32_t dst=from;
+   for(uint32_t src=to+1;src<m_data_total;src++,dst++)
+      m_data[dst]=std::move(m_data[src]);
+   for(uint32_t i=dst;i<m_data_total;i++)
+      m_data[i].~T();
+   m_data_total=dst;
+//--- ok
+   return(true);
+  }
+//+------------------------------------------------------------------+
+//| Memory check and reallocation to store 'total' records           |
+//+------------------------------------------------------------------+
+template <class T,uint32_t step,class TGrowth>
+inline bool TMTVector<T,step,TGrowth>::Realloc(const uint32_t total)
+  {
+//--- check size
+   if(m_data && (uint64_t(m_data_total)+total)<=m_data_max) return(true);
+//--- allocate new buffer
+   uint32_t max;
+   T       *buffer=Allocate(total,max);
+   if(!buffer) return(false);
+//--- move previous data and replace
+   Replace(buffer,max);
+//--- ok
+   return(true);
+  }
+//+------------------------------------------------------------------+
+//| Allocate uninitialized buffer for 'total' more records           |
+//+------------------------------------------------------------------+
+template <class T,uint32_t step,class TGrowth>
+inline T* TMTVector<T,step,TGrowth>::Allocate(const uint32_t total,uint32_t &max) const
+  {
+//--- calculate reallocation
+   uint32_t add=((total/step)+1)*step;
+//--- geometric growth by half of the allocated size, limited by cap
+   if(TGrowth::GEOMETRIC)
+     {
+      uint32_t grow=m_data_max/2;
+      if(TGrowth::CAP && grow>TGrowth::CAP)
+         grow=TGrowth::CAP;
+      if(grow>add && uint64_t(m_data_max)+grow<=0xFFFFFFFF)
+         add=grow;
+     }
+//--- allocate
+   max=m_data_max+add;
+   return((T*)::operator new(sizeof(T)*size_t(max),std::nothrow));
+  }
+//+------------------------------------------------------------------+
+//| Move elements to the new buffer and free the old one             |
+//+------------------------------------------------------------------+
+template <class T,uint32_t step,class TGrowth>
+inline void TMTVector<T,step,TGrowth>::Replace(T *buffer,const uint32_t max)
+  {
+   if(m_data)
+     {
+      Relocate(buffer,m_data,m_data_total);
+      ::operator delete(m_data);
+     }
+   m_data    =buffer;
+   m_data_max=max;
+  }
+//+------------------------------------------------------------------+
+//| Move elements into uninitialized memory and destroy sources      |
+//+------------------------------------------------------------------+
+template <class T,uint32_t step,class TGrowth>
+inline void TMTVector<T,step,TGrowth>::Relocate(T *dst,T *src,const uint32_t total)
+  {
+   if(std::is_trivially_copyable<T>::value)
+     {
+      if(total) memcpy((void*)dst,(const void*)src,sizeof(T)*total);
+      return;
+     }
+   for(uint32_t i=0;i<total;i++)
+     {
+      new(dst+i) T(std::move(src[i]));
+      src[i].~T();
+     }
+  }
+//+------------------------------------------------------------------+
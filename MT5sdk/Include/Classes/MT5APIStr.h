@@ -10,6 +10,18 @@
 #include <string.h>
 #include <memory.h>
 #include <winnls.h>
+//--- SIMD text conversion
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define MTAPI_STR_SSE2
+#include <emmintrin.h>
+#if defined(__AVX2__)
+#define MTAPI_STR_AVX2
+#include <immintrin.h>
+#endif
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 //+------------------------------------------------------------------+
 //| String base class                                                |
 //+------------------------------------------------------------------+
@@ -41,6 +53,8 @@ public:
    void              Assign(LPCWSTR from,const uint32_t from_len);
    void              Assign(LPCSTR from);
    void              Assign(LPCSTR from,const uint32_t from_len);
+   void              AssignUtf8(LPCSTR from);
+   void              AssignUtf8(LPCSTR from,const uint32_t from_len);
    //--- operations
    int32_t           Format(LPCWSTR fmt,...);
    void              ToLower(void);
@@ -90,6 +104,10 @@ public:
    static void       Copy(LPSTR dst,uint32_t dstsize,LPCWSTR src);
    static void       Copy(LPWSTR dst,uint32_t dstsize,LPCSTR src);
    static void       CopyCodePage(LPWSTR dst,uint32_t dstsize,LPCSTR src,uint32_t codepage);
+   //--- UTF-8 conversion
+   uint32_t          ToUtf8(LPSTR string,uint32_t maxlen) const;
+   static uint32_t   Utf8ToWide(LPWSTR dst,uint32_t dstsize,LPCSTR src,uint32_t srclen);
+   static uint32_t   WideToUtf8(LPSTR dst,uint32_t dstsize,LPCWSTR src,uint32_t srclen);
    //--- compare
    int32_t           Compare(LPCWSTR str) const;
    int32_t           Compare(LPCWSTR str,uint32_t count) const;
@@ -130,6 +148,12 @@ protected:
      }
 private:
    static bool       CheckGroupTemplate(LPWSTR expr,LPCWSTR group);
+   //--- search and comparison with ASCII fast path
+   static wchar_t    FoldAscii(const wchar_t c) { return((c>=L'A' && c<=L'Z') ? wchar_t(c+(L'a'-L'A')) : c); }
+   static uint32_t   LowestBit(const uint32_t mask);
+   static int32_t    CompareNoCaseFast(LPCWSTR str1,LPCWSTR str2,uint32_t count);
+   static int32_t    FindFast(LPCWSTR str,uint32_t len,LPCWSTR substr,uint32_t sublen,const bool nocase);
+   static bool       FindCheck(LPCWSTR str,LPCWSTR substr,uint32_t sublen,const bool nocase);
   };
 //+------------------------------------------------------------------+
 //| Stack string template                                            |
@@ -348,6 +372,232 @@ inline void CMTStr::CopyCodePage(LPWSTR dst,uint32_t dstsize,LPCSTR src,uint32_t
       ::MultiByteToWideChar(codepage,0,src,-1,dst,int(dstsize));
   }
 //+------------------------------------------------------------------+
+//| Assign from UTF-8 string                                         |
+//+------------------------------------------------------------------+
+inline void CMTStr::AssignUtf8(LPCSTR from)
+  {
+//--- check
+   if(m_str)
+     {
+      //--- check empty string
+      if(!from) m_str[m_str_len=0]=0;
+      else      m_str_len=Utf8ToWide(m_str,m_str_max,from,(uint32_t)strlen(from));
+     }
+  }
+//+------------------------------------------------------------------+
+//| Assign from UTF-8 string with length, stops at zero char         |
+//+------------------------------------------------------------------+
+inline void CMTStr::AssignUtf8(LPCSTR from,const uint32_t from_len)
+  {
+//--- check
+   if(m_str)
+     {
+      //--- check empty string
+      if(!from) m_str[m_str_len=0]=0;
+      else      m_str_len=Utf8ToWide(m_str,m_str_max,from,(uint32_t)strnlen(from,from_len));
+     }
+  }
+//+------------------------------------------------------------------+
+//| Copy to UTF-8 string, returns length without zero char           |
+//+------------------------------------------------------------------+
+inline uint32_t CMTStr::ToUtf8(LPSTR string,uint32_t maxlen) const
+  {
+   if(string && maxlen>0)
+      return(WideToUtf8(string,maxlen,m_str,m_str ? m_str_len : 0));
+   return(0);
+  }
+//+------------------------------------------------------------------+
+//| Convert UTF-8 to UTF-16                                          |
+//| ASCII blocks are widened by SIMD, other chars are decoded one    |
+//| by one, invalid sequences are replaced by U+FFFD, the result is  |
+//| cut on char boundary and always terminated                       |
+//| returns length of result without zero char                       |
+//+------------------------------------------------------------------+
+inline uint32_t CMTStr::Utf8ToWide(LPWSTR dst,uint32_t dstsize,LPCSTR src,uint32_t srclen)
+  {
+   const uint8_t *str=(const uint8_t*)src;
+   uint32_t       pos=0,len=0;
+//--- check
+   if(!dst || !dstsize)
+      return(0);
+   if(!src)
+      srclen=0;
+//--- convert
+   const uint32_t max=dstsize-1;
+   while(pos<srclen && len<max)
+     {
+#ifdef MTAPI_STR_AVX2
+      //--- blocks of 32 ASCII chars
+      while(srclen-pos>=32 && max-len>=32)
+        {
+         const __m256i chars=_mm256_loadu_si256((const __m256i*)(str+pos));
+         if(_mm256_movemask_epi8(chars))
+            break;
+         _mm256_storeu_si256((__m256i*)(dst+len)   ,_mm256_cvtepu8_epi16(_mm256_castsi256_si128(chars)));
+         _mm256_storeu_si256((__m256i*)(dst+len+16),_mm256_cvtepu8_epi16(_mm256_extracti128_si256(chars,1)));
+         pos+=32;
+         len+=32;
+        }
+#endif
+#ifdef MTAPI_STR_SSE2
+      //--- blocks of 16 ASCII chars
+      while(srclen-pos>=16 && max-len>=16)
+        {
+         const __m128i chars=_mm_loadu_si128((const __m128i*)(str+pos));
+         if(_mm_movemask_epi8(chars))
+            break;
+         _mm_storeu_si128((__m128i*)(dst+len)  ,_mm_unpacklo_epi8(chars,_mm_setzero_si128()));
+         _mm_storeu_si128((__m128i*)(dst+len+8),_mm_unpackhi_epi8(chars,_mm_setzero_si128()));
+         pos+=16;
+         len+=16;
+        }
+      if(pos>=srclen || len>=max)
+         break;
+#endif
+      //--- ASCII char
+      const uint32_t lead=str[pos];
+      if(lead<0x80)
+        {
+         dst[len++]=wchar_t(lead);
+         pos++;
+         continue;
+        }
+      //--- sequence length and lead bits, overlong 2 bytes leads are invalid
+      uint32_t tail,code;
+      if(lead>=0xC2 && lead<=0xDF)      { tail=1; code=lead & 0x1F; }
+      else if(lead>=0xE0 && lead<=0xEF) { tail=2; code=lead & 0x0F; }
+      else if(lead>=0xF0 && lead<=0xF4) { tail=3; code=lead & 0x07; }
+      else                              { tail=0; code=0xFFFD;      }
+      //--- continuation bytes
+      uint32_t i=1;
+      for(; i<=tail && pos+i<srclen && (str[pos+i] & 0xC0)==0x80; i++)
+         code=(code<<6) | (str[pos+i] & 0x3F);
+      //--- check truncated, overlong, surrogate and out of range chars
+      if(i<=tail || (tail==2 && code<0x800) || (tail==3 && (code<0x10000 || code>0x10FFFF)) || (code>=0xD800 && code<=0xDFFF))
+        {
+         //--- replace lead byte, resync on the next one
+         dst[len++]=wchar_t(0xFFFD);
+         pos++;
+         continue;
+        }
+      //--- write char or surrogate pair
+      if(code<0x10000)
+         dst[len++]=wchar_t(code);
+      else
+        {
+         if(max-len<2)
+            break;
+         code-=0x10000;
+         dst[len++]=wchar_t(0xD800+(code>>10));
+         dst[len++]=wchar_t(0xDC00+(code & 0x3FF));
+        }
+      pos+=tail+1;
+     }
+//--- terminate
+   dst[len]=0;
+   return(len);
+  }
+//+------------------------------------------------------------------+
+//| Convert UTF-16 to UTF-8                                          |
+//| ASCII blocks are narrowed by SIMD, other chars are encoded one   |
+//| by one, unpaired surrogates are replaced by U+FFFD, the result   |
+//| is cut on char boundary and always terminated                    |
+//| returns length of result without zero char                       |
+//+------------------------------------------------------------------+
+inline uint32_t CMTStr::WideToUtf8(LPSTR dst,uint32_t dstsize,LPCWSTR src,uint32_t srclen)
+  {
+   uint8_t *str=(uint8_t*)dst;
+   uint32_t pos=0,len=0;
+//--- check
+   if(!dst || !dstsize)
+      return(0);
+   if(!src)
+      srclen=0;
+//--- convert
+   const uint32_t max=dstsize-1;
+   while(pos<srclen && len<max)
+     {
+#ifdef MTAPI_STR_AVX2
+      //--- blocks of 32 ASCII chars
+      while(srclen-pos>=32 && max-len>=32)
+        {
+         const __m256i lo=_mm256_loadu_si256((const __m256i*)(src+pos));
+         const __m256i hi=_mm256_loadu_si256((const __m256i*)(src+pos+16));
+         if(!_mm256_testz_si256(_mm256_or_si256(lo,hi),_mm256_set1_epi16(short(0xFF80))))
+            break;
+         //--- pack works within 128-bit lanes, restore order of quadwords
+         _mm256_storeu_si256((__m256i*)(str+len),_mm256_permute4x64_epi64(_mm256_packus_epi16(lo,hi),0xD8));
+         pos+=32;
+         len+=32;
+        }
+#endif
+#ifdef MTAPI_STR_SSE2
+      //--- blocks of 16 ASCII chars
+      while(srclen-pos>=16 && max-len>=16)
+        {
+         const __m128i lo=_mm_loadu_si128((const __m128i*)(src+pos));
+         const __m128i hi=_mm_loadu_si128((const __m128i*)(src+pos+8));
+         const __m128i non_ascii=_mm_and_si128(_mm_or_si128(lo,hi),_mm_set1_epi16(short(0xFF80)));
+         if(_mm_movemask_epi8(_mm_cmpeq_epi16(non_ascii,_mm_setzero_si128()))!=0xFFFF)
+            break;
+         _mm_storeu_si128((__m128i*)(str+len),_mm_packus_epi16(lo,hi));
+         pos+=16;
+         len+=16;
+        }
+      if(pos>=srclen || len>=max)
+         break;
+#endif
+      //--- ASCII char
+      uint32_t code=uint16_t(src[pos]);
+      if(code<0x80)
+        {
+         str[len++]=uint8_t(code);
+         pos++;
+         continue;
+        }
+      //--- surrogate pair
+      uint32_t units=1;
+      if(code>=0xD800 && code<=0xDFFF)
+        {
+         const uint32_t next=(pos+1<srclen) ? uint16_t(src[pos+1]) : 0;
+         if(code<=0xDBFF && next>=0xDC00 && next<=0xDFFF)
+           {
+            code =0x10000+((code-0xD800)<<10)+(next-0xDC00);
+            units=2;
+           }
+         else
+            code=0xFFFD;
+        }
+      //--- encode
+      if(code<0x800)
+        {
+         if(max-len<2)
+            break;
+         str[len++]=uint8_t(0xC0 | (code>>6));
+        }
+      else if(code<0x10000)
+        {
+         if(max-len<3)
+            break;
+         str[len++]=uint8_t(0xE0 | (code>>12));
+         str[len++]=uint8_t(0x80 | ((code>>6) & 0x3F));
+        }
+      else
+        {
+         if(max-len<4)
+            break;
+         str[len++]=uint8_t(0xF0 | (code>>18));
+         str[len++]=uint8_t(0x80 | ((code>>12) & 0x3F));
+         str[len++]=uint8_t(0x80 | ((code>>6) & 0x3F));
+        }
+      str[len++]=uint8_t(0x80 | (code & 0x3F));
+      pos+=units;
+     }
+//--- terminate
+   str[len]=0;
+   return(len);
+  }
+//+------------------------------------------------------------------+
 //| String format                                                    |
 //+------------------------------------------------------------------+
 inline int32_t CMTStr::Format(LPCWSTR fmt,...)
@@ -736,7 +986,7 @@ inline int32_t CMTStr::Compare(LPCWSTR str1,LPCWSTR str2,uint32_t count)
 //+------------------------------------------------------------------+
 inline int32_t CMTStr::CompareNoCase(LPCWSTR str) const
   {
-   if(m_str && str) return _wcsicmp(m_str,str);
+   if(m_str && str) return CompareNoCaseFast(m_str,str,UINT_MAX);
    return(m_str_len<1 ? 0 : 1);
   }
 //+------------------------------------------------------------------+
@@ -744,7 +994,7 @@ inline int32_t CMTStr::CompareNoCase(LPCWSTR str) const
 //+------------------------------------------------------------------+
 inline int32_t CMTStr::CompareNoCase(LPCWSTR str,uint32_t count) const
   {
-   if(m_str && str) return _wcsnicmp(m_str,str,count);
+   if(m_str && str) return CompareNoCaseFast(m_str,str,count);
    return(m_str_len<1 ? 0 : 1);
   }
 //+------------------------------------------------------------------+
@@ -752,7 +1002,7 @@ inline int32_t CMTStr::CompareNoCase(LPCWSTR str,uint32_t count) const
 //+------------------------------------------------------------------+
 inline int32_t CMTStr::CompareNoCase(const CMTStr& str) const
   {
-   if(m_str && str.m_str) return _wcsicmp(m_str,str.m_str);
+   if(m_str && str.m_str) return CompareNoCaseFast(m_str,str.m_str,UINT_MAX);
    return(m_str_len<1 ? 0 : 1);
   }
 //+------------------------------------------------------------------+
@@ -760,14 +1010,74 @@ inline int32_t CMTStr::CompareNoCase(const CMTStr& str) const
 //+------------------------------------------------------------------+
 inline int32_t CMTStr::CompareNoCase(LPCWSTR str1,LPCWSTR str2)
   {
-   return _wcsicmp(str1,str2);
+   return CompareNoCaseFast(str1,str2,UINT_MAX);
   }
 //+------------------------------------------------------------------+
 //| Compare no case                                                  |
 //+------------------------------------------------------------------+
 inline int32_t CMTStr::CompareNoCase(LPCWSTR str1,LPCWSTR str2,uint32_t count)
   {
-   return _wcsnicmp(str1,str2,count);
+   return CompareNoCaseFast(str1,str2,count);
+  }
+//+------------------------------------------------------------------+
+//| Compare no case up to count chars                                |
+//| ASCII chars are folded by SIMD, 8 chars per step, the rest of    |
+//| strings from the first non-ASCII char is compared by _wcsnicmp   |
+//| blocks are not loaded across page boundary, so reading past      |
+//| the terminator is safe                                           |
+//+------------------------------------------------------------------+
+inline int32_t CMTStr::CompareNoCaseFast(LPCWSTR str1,LPCWSTR str2,uint32_t count)
+  {
+   uint32_t pos=0;
+//--- check
+   if(!str1 || !str2)
+      return(_wcsnicmp(str1,str2,count));
+//--- compare
+   while(pos<count)
+     {
+#ifdef MTAPI_STR_SSE2
+      if(sizeof(wchar_t)==sizeof(uint16_t))
+        {
+         const __m128i upper_base =_mm_set1_epi16(short(0x8000-L'A'));
+         const __m128i upper_limit=_mm_set1_epi16(short(0x8000+26));
+         const __m128i lower_bit  =_mm_set1_epi16(0x20);
+         const __m128i non_ascii  =_mm_set1_epi16(short(0xFF80));
+         const __m128i zero       =_mm_setzero_si128();
+         //--- blocks of 8 chars inside page
+         while(count-pos>=8 && (((uintptr_t)(str1+pos)) & 4095)<=4096-16 && (((uintptr_t)(str2+pos)) & 4095)<=4096-16)
+           {
+            __m128i a=_mm_loadu_si128((const __m128i*)(str1+pos));
+            __m128i b=_mm_loadu_si128((const __m128i*)(str2+pos));
+            //--- stop on terminator and non-ASCII chars
+            const __m128i stop=_mm_or_si128(_mm_cmpeq_epi16(a,zero),_mm_cmpeq_epi16(_mm_cmpeq_epi16(_mm_and_si128(_mm_or_si128(a,b),non_ascii),zero),zero));
+            //--- fold 'A'-'Z'
+            a=_mm_or_si128(a,_mm_and_si128(_mm_cmplt_epi16(_mm_add_epi16(a,upper_base),upper_limit),lower_bit));
+            b=_mm_or_si128(b,_mm_and_si128(_mm_cmplt_epi16(_mm_add_epi16(b,upper_base),upper_limit),lower_bit));
+            //--- stop on difference too
+            const uint32_t mask=uint32_t(_mm_movemask_epi8(_mm_or_si128(stop,_mm_cmpeq_epi16(_mm_cmpeq_epi16(a,b),zero))));
+            if(mask)
+              {
+               pos+=LowestBit(mask)/2;
+               break;
+              }
+            pos+=8;
+           }
+         if(pos>=count)
+            break;
+        }
+#endif
+      //--- non-ASCII char, current behaviour for the rest
+      const wchar_t c1=str1[pos],c2=str2[pos];
+      if(c1>=0x80 || c2>=0x80)
+         return(_wcsnicmp(str1+pos,str2+pos,count-pos));
+      //--- ASCII char
+      const int32_t diff=int32_t(FoldAscii(c1))-int32_t(FoldAscii(c2));
+      if(diff || !c1)
+         return(diff);
+      pos++;
+     }
+//--- equal
+   return(0);
   }
 //+------------------------------------------------------------------+
 //| Check group correspondence to groups mask list                   |
@@ -815,8 +1125,10 @@ inline int32_t CMTStr::Find(LPCWSTR substring,uint32_t startpos) const
    if(substring && m_str && m_str_len>0)
       if(startpos<m_str_len)
         {
-         wchar_t *position=wcsstr(m_str+startpos,substring);
-         if(position) return int(position-m_str);
+         //--- empty substring is found at start
+         if(!substring[0]) return int(startpos);
+         const int32_t pos=FindFast(m_str+startpos,m_str_len-startpos,substring,Len(substring),false);
+         if(pos>=0) return int(startpos+pos);
         }
    return(-1);
   }
@@ -827,11 +1139,9 @@ inline int32_t CMTStr::Find(LPCWSTR substring) const
   {
    if(substring && m_str && m_str_len>0)
      {
-      wchar_t *position=wcsstr(m_str,substring);
-      if(position)
-        {
-         return int(position-m_str);
-        }
+      //--- empty substring is found at start
+      if(!substring[0]) return(0);
+      return FindFast(m_str,m_str_len,substring,Len(substring),false);
      }
    return(-1);
   }
@@ -844,9 +1154,10 @@ inline int32_t CMTStr::FindNoCase(LPCWSTR substring,uint32_t startpos) const
 //---
    if(substring && (sublen=(uint32_t)wcslen(substring))>0 && m_str && m_str_len>0)
       if(startpos<m_str_len)
-         for(uint32_t pos=startpos;m_str_len-pos>=sublen;pos++)
-            if(_wcsnicmp(m_str+pos,substring,sublen)==0)
-               return int(pos);
+        {
+         const int32_t pos=FindFast(m_str+startpos,m_str_len-startpos,substring,sublen,true);
+         if(pos>=0) return int(startpos+pos);
+        }
    return(-1);
   }
 //+------------------------------------------------------------------+
@@ -898,10 +1209,7 @@ inline int32_t CMTStr::FindRChar(const wchar_t character) const
 inline int32_t CMTStr::Find(LPCWSTR str,LPCWSTR substr)
   {
    if(str && substr && substr[0]!=L'\0')
-     {
-      LPCWSTR ptr=wcsstr(str,substr);
-      if(ptr) return int(ptr-str);
-     }
+      return FindFast(str,Len(str),substr,Len(substr),false);
    return(-1);
   }
 //+------------------------------------------------------------------+
@@ -912,9 +1220,7 @@ inline int32_t CMTStr::FindNoCase(LPCWSTR str,LPCWSTR substr)
    uint32_t len=0,sublen=0;
 //---
    if(str && substr && (len=(uint32_t)wcslen(str))>0 && (sublen=(uint32_t)wcslen(substr))>0)
-      for(uint32_t pos=0;len>=pos+sublen;pos++)
-         if(_wcsnicmp(str+pos,substr,sublen)==0)
-            return int(pos);
+      return FindFast(str,len,substr,sublen,true);
    return(-1);
   }
 //+------------------------------------------------------------------+
@@ -961,6 +1267,134 @@ inline int32_t CMTStr::FindRChar(LPCWSTR str,wchar_t character)
    return(-1);
   }
 //+------------------------------------------------------------------+
+//| Index of the lowest bit set                                      |
+//+------------------------------------------------------------------+
+inline uint32_t CMTStr::LowestBit(const uint32_t mask)
+  {
+#if defined(_MSC_VER)
+   unsigned long idx=0;
+   _BitScanForward(&idx,mask);
+   return(uint32_t(idx));
+#else
+   return(uint32_t(__builtin_ctz(mask)));
+#endif
+  }
+//+------------------------------------------------------------------+
+//| Find substring in string with known lengths                      |
+//| candidates are filtered by the first and the last chars of       |
+//| substring, 8 or 16 positions per step, then checked completely   |
+//| in no case mode non-ASCII chars of the string pass the filter    |
+//| and are checked by _wcsnicmp, substring with non-ASCII chars is  |
+//| searched by _wcsnicmp at each position                           |
+//+------------------------------------------------------------------+
+inline int32_t CMTStr::FindFast(LPCWSTR str,uint32_t len,LPCWSTR substr,uint32_t sublen,const bool nocase)
+  {
+   uint32_t pos=0;
+//--- check
+   if(!sublen || sublen>len)
+      return(-1);
+//--- substring with non-ASCII chars, current behaviour
+   if(nocase)
+      for(uint32_t i=0; i<sublen; i++)
+         if(substr[i]>=0x80)
+           {
+            for(pos=0; len-pos>=sublen; pos++)
+               if(_wcsnicmp(str+pos,substr,sublen)==0)
+                  return int(pos);
+            return(-1);
+           }
+//--- positions to check
+   const uint32_t total=len-sublen+1;
+   const wchar_t  first=nocase ? FoldAscii(substr[0])        : substr[0];
+   const wchar_t  last =nocase ? FoldAscii(substr[sublen-1]) : substr[sublen-1];
+#ifdef MTAPI_STR_SSE2
+   if(sizeof(wchar_t)==sizeof(uint16_t))
+     {
+#ifdef MTAPI_STR_AVX2
+      const __m256i upper_base256 =_mm256_set1_epi16(short(0x8000-L'A'));
+      const __m256i upper_limit256=_mm256_set1_epi16(short(0x8000+26));
+      const __m256i lower_bit256  =_mm256_set1_epi16(nocase ? 0x20 : 0);
+      const __m256i non_ascii256  =_mm256_set1_epi16(short(nocase ? 0xFF80 : 0));
+      const __m256i first256      =_mm256_set1_epi16(short(first));
+      const __m256i last256       =_mm256_set1_epi16(short(last));
+      //--- 16 positions per step
+      for(; total-pos>=16; pos+=16)
+        {
+         __m256i a=_mm256_loadu_si256((const __m256i*)(str+pos));
+         __m256i b=_mm256_loadu_si256((const __m256i*)(str+pos+sublen-1));
+         const __m256i a_wide=_mm256_andnot_si256(_mm256_cmpeq_epi16(_mm256_and_si256(a,non_ascii256),_mm256_setzero_si256()),_mm256_set1_epi16(-1));
+         const __m256i b_wide=_mm256_andnot_si256(_mm256_cmpeq_epi16(_mm256_and_si256(b,non_ascii256),_mm256_setzero_si256()),_mm256_set1_epi16(-1));
+         a=_mm256_or_si256(a,_mm256_and_si256(_mm256_cmpgt_epi16(upper_limit256,_mm256_add_epi16(a,upper_base256)),lower_bit256));
+         b=_mm256_or_si256(b,_mm256_and_si256(_mm256_cmpgt_epi16(upper_limit256,_mm256_add_epi16(b,upper_base256)),lower_bit256));
+         uint32_t mask=uint32_t(_mm256_movemask_epi8(_mm256_and_si256(_mm256_or_si256(_mm256_cmpeq_epi16(a,first256),a_wide),
+                                                                      _mm256_or_si256(_mm256_cmpeq_epi16(b,last256),b_wide))));
+         for(; mask; mask&=mask-1,mask&=mask-1)
+           {
+            const uint32_t found=pos+LowestBit(mask)/2;
+            if(FindCheck(str+found,substr,sublen,nocase))
+               return int(found);
+           }
+        }
+#endif
+      const __m128i upper_base =_mm_set1_epi16(short(0x8000-L'A'));
+      const __m128i upper_limit=_mm_set1_epi16(short(0x8000+26));
+      const __m128i lower_bit  =_mm_set1_epi16(nocase ? 0x20 : 0);
+      const __m128i non_ascii  =_mm_set1_epi16(short(nocase ? 0xFF80 : 0));
+      const __m128i first128   =_mm_set1_epi16(short(first));
+      const __m128i last128    =_mm_set1_epi16(short(last));
+      //--- 8 positions per step
+      for(; total-pos>=8; pos+=8)
+        {
+         __m128i a=_mm_loadu_si128((const __m128i*)(str+pos));
+         __m128i b=_mm_loadu_si128((const __m128i*)(str+pos+sublen-1));
+         //--- non-ASCII chars pass the filter in no case mode
+         const __m128i a_wide=_mm_cmpeq_epi16(_mm_cmpeq_epi16(_mm_and_si128(a,non_ascii),_mm_setzero_si128()),_mm_setzero_si128());
+         const __m128i b_wide=_mm_cmpeq_epi16(_mm_cmpeq_epi16(_mm_and_si128(b,non_ascii),_mm_setzero_si128()),_mm_setzero_si128());
+         //--- fold 'A'-'Z' in no case mode
+         a=_mm_or_si128(a,_mm_and_si128(_mm_cmplt_epi16(_mm_add_epi16(a,upper_base),upper_limit),lower_bit));
+         b=_mm_or_si128(b,_mm_and_si128(_mm_cmplt_epi16(_mm_add_epi16(b,upper_base),upper_limit),lower_bit));
+         //--- two mask bits per position
+         uint32_t mask=uint32_t(_mm_movemask_epi8(_mm_and_si128(_mm_or_si128(_mm_cmpeq_epi16(a,first128),a_wide),
+                                                                _mm_or_si128(_mm_cmpeq_epi16(b,last128),b_wide))));
+         for(; mask; mask&=mask-1,mask&=mask-1)
+           {
+            const uint32_t found=pos+LowestBit(mask)/2;
+            if(FindCheck(str+found,substr,sublen,nocase))
+               return int(found);
+           }
+        }
+     }
+#endif
+//--- remaining positions
+   for(; pos<total; pos++)
+     {
+      const wchar_t a=str[pos],b=str[pos+sublen-1];
+      if(nocase ? ((FoldAscii(a)==first || a>=0x80) && (FoldAscii(b)==last || b>=0x80)) : (a==first && b==last))
+         if(FindCheck(str+pos,substr,sublen,nocase))
+            return int(pos);
+     }
+//--- not found
+   return(-1);
+  }
+//+------------------------------------------------------------------+
+//| Check substring at position                                      |
+//+------------------------------------------------------------------+
+inline bool CMTStr::FindCheck(LPCWSTR str,LPCWSTR substr,uint32_t sublen,const bool nocase)
+  {
+//--- exact match
+   if(!nocase)
+      return(wmemcmp(str,substr,sublen)==0);
+//--- substring is ASCII here, non-ASCII chars of string are checked by _wcsnicmp
+   for(uint32_t i=0; i<sublen; i++)
+     {
+      if(str[i]>=0x80)
+         return(_wcsnicmp(str,substr,sublen)==0);
+      if(FoldAscii(str[i])!=FoldAscii(substr[i]))
+         return(false);
+     }
+   return(true);
+  }
+//+------------------------------------------------------------------+
 //| Check group by expression                                        |
 //+------------------------------------------------------------------+
 inline bool CMTStr::CheckGroupTemplate(LPWSTR expr,LPCWSTR group)
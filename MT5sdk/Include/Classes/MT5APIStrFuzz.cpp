@@ -0,0 +1,215 @@
+//+------------------------------------------------------------------+
+//|                                                 MetaTrader 5 API |
+//|                             Copyright 2000-2025, MetaQuotes Ltd. |
+//|                                               www.metaquotes.net |
+//+------------------------------------------------------------------+
+//| Correctness fuzz test of CMTStr search and comparison            |
+//| CompareNoCase, Find and FindNoCase are checked against the CRT   |
+//| functions they replace and against a reference ASCII case fold,  |
+//| strings are placed right before a guard page, so any SIMD read   |
+//| past the terminator across the page boundary fails at once       |
+//| Build as a console application: cl /O2 /EHsc MT5APIStrFuzz.cpp  |
+//+------------------------------------------------------------------+
+#include <windows.h>
+#include <stdint.h>
+#include <random>
+#include "..\MT5APITypes.h"
+#include "MT5APIStr.h"
+//+------------------------------------------------------------------+
+//| Constants                                                        |
+//+------------------------------------------------------------------+
+enum EnFuzzConstants
+  {
+   FUZZ_ITERATIONS =300000,                // iterations
+   FUZZ_STR_MAX    =300,                   // maximum string length
+   FUZZ_SUB_MAX    =20,                    // maximum substring length
+   FUZZ_PAGE       =4096,                  // page size
+   FUZZ_ERRORS_MAX =10                     // errors to print
+  };
+//+------------------------------------------------------------------+
+//| Alphabet: case pairs, chars around 'A'-'Z' and 'a'-'z' bounds,   |
+//| Latin-1 letters and chars with the sign bit of 16-bit lanes      |
+//+------------------------------------------------------------------+
+static const wchar_t ExtAlphabet[]=
+  {
+   L'a',L'b',L'A',L'B',L'k',L'K',L'i',L'I',L'@',L'[',L'`',L'{',L'_',L'z',L'Z',
+   0xC0,0xE0,0x212A,0x130,0x8000,0xFFFF,0xD7,0xF7
+  };
+static const uint32_t ExtAlphabetAscii=15;
+//+------------------------------------------------------------------+
+//| Reference ASCII case fold                                        |
+//+------------------------------------------------------------------+
+static wchar_t RefFold(const wchar_t c)
+  {
+   return((c>=L'A' && c<=L'Z') ? wchar_t(c+(L'a'-L'A')) : c);
+  }
+//+------------------------------------------------------------------+
+//| Reference search by the case fold, -1 if not found               |
+//+------------------------------------------------------------------+
+static int32_t RefFind(LPCWSTR str,uint32_t len,LPCWSTR substr,uint32_t sublen,const bool nocase)
+  {
+   for(uint32_t pos=0; sublen && pos+sublen<=len; pos++)
+     {
+      uint32_t i=0;
+      while(i<sublen && (nocase ? RefFold(str[pos+i])==RefFold(substr[i]) : str[pos+i]==substr[i]))
+         i++;
+      if(i==sublen)
+         return(int32_t(pos));
+     }
+   return(-1);
+  }
+//+------------------------------------------------------------------+
+//| Previous FindNoCase: _wcsnicmp at each position                  |
+//+------------------------------------------------------------------+
+static int32_t CrtFindNoCase(LPCWSTR str,uint32_t len,LPCWSTR substr,uint32_t sublen)
+  {
+   for(uint32_t pos=0; sublen && pos+sublen<=len; pos++)
+      if(_wcsnicmp(str+pos,substr,sublen)==0)
+         return(int32_t(pos));
+   return(-1);
+  }
+//+------------------------------------------------------------------+
+//| Previous Find: wcsstr                                            |
+//+------------------------------------------------------------------+
+static int32_t CrtFind(LPCWSTR str,LPCWSTR substr)
+  {
+   LPCWSTR ptr=wcsstr(str,substr);
+   return(ptr ? int32_t(ptr-str) : -1);
+  }
+//+------------------------------------------------------------------+
+//| Sign of comparison result                                        |
+//+------------------------------------------------------------------+
+static int32_t Sign(const int32_t res)
+  {
+   return((res>0)-(res<0));
+  }
+//+------------------------------------------------------------------+
+//| Check for ASCII only string                                      |
+//+------------------------------------------------------------------+
+static bool IsAscii(LPCWSTR str,const uint32_t len)
+  {
+   for(uint32_t i=0; i<len; i++)
+      if(str[i]>=0x80)
+         return(false);
+   return(true);
+  }
+//+------------------------------------------------------------------+
+//| Report error                                                     |
+//+------------------------------------------------------------------+
+static void Error(uint32_t &errors,LPCWSTR test,const uint32_t iteration,const int32_t res,const int32_t ref)
+  {
+   if(errors++<FUZZ_ERRORS_MAX)
+      wprintf_s(L"%s failed at iteration %u: result %d, reference %d\n",test,iteration,res,ref);
+  }
+//+------------------------------------------------------------------+
+//| Main entry point                                                 |
+//+------------------------------------------------------------------+
+int32_t wmain(int32_t argc,wchar_t* argv[])
+  {
+   wchar_t        str_buf[FUZZ_STR_MAX+1],cmp_buf[FUZZ_STR_MAX+1],sub[FUZZ_SUB_MAX+1];
+   std::mt19937   rng(argc>1 ? _wtoi(argv[1]) : 7);
+   uint32_t       errors=0;
+   DWORD          protect=0;
+//--- two data pages, each followed by a guard page
+   char *mem=(char*)VirtualAlloc(NULL,FUZZ_PAGE*4,MEM_RESERVE|MEM_COMMIT,PAGE_READWRITE);
+   if(!mem)
+     {
+      wprintf_s(L"VirtualAlloc failed [%u]\n",GetLastError());
+      return(-1);
+     }
+   if(!VirtualProtect(mem+FUZZ_PAGE,FUZZ_PAGE,PAGE_NOACCESS,&protect) || !VirtualProtect(mem+FUZZ_PAGE*3,FUZZ_PAGE,PAGE_NOACCESS,&protect))
+     {
+      wprintf_s(L"VirtualProtect failed [%u]\n",GetLastError());
+      VirtualFree(mem,0,MEM_RELEASE);
+      return(-1);
+     }
+   wchar_t *str_end=(wchar_t*)(mem+FUZZ_PAGE);
+   wchar_t *cmp_end=(wchar_t*)(mem+FUZZ_PAGE*3);
+//--- fuzz
+   for(uint32_t iter=0; iter<FUZZ_ITERATIONS; iter++)
+     {
+      //--- full alphabet, ASCII only or a narrow one for many candidates
+      const uint32_t alphabet=(iter%3==0) ? _countof(ExtAlphabet) : (iter%3==1) ? ExtAlphabetAscii : 4;
+      const uint32_t len     =rng()%FUZZ_STR_MAX;
+      const uint32_t sublen  =1+rng()%((iter%5==0) ? FUZZ_SUB_MAX : 4);
+      for(uint32_t i=0; i<len; i++)
+         str_buf[i]=ExtAlphabet[rng()%alphabet];
+      str_buf[len]=0;
+      for(uint32_t i=0; i<sublen; i++)
+         sub[i]=ExtAlphabet[rng()%alphabet];
+      sub[sublen]=0;
+      //--- plant the substring with mixed case
+      if(len>=sublen && rng()%2)
+        {
+         const uint32_t pos=rng()%(len-sublen+1);
+         for(uint32_t i=0; i<sublen; i++)
+            str_buf[pos+i]=(rng()%3) ? sub[i] : RefFold(sub[i]);
+        }
+      //--- string ends right before the guard page
+      wchar_t *str=str_end-(len+1);
+      memcpy(str,str_buf,(len+1)*sizeof(wchar_t));
+      const bool ascii=IsAscii(str,len) && IsAscii(sub,sublen);
+      //--- Find
+      int32_t res=CMTStr::Find(str,sub),ref=len ? CrtFind(str,sub) : -1;
+      if(res!=ref || res!=RefFind(str,len,sub,sublen,false))
+         Error(errors,L"Find",iter,res,ref);
+      //--- FindNoCase
+      res=CMTStr::FindNoCase(str,sub);
+      ref=CrtFindNoCase(str,len,sub,sublen);
+      if(res!=ref || (ascii && res!=RefFind(str,len,sub,sublen,true)))
+         Error(errors,L"FindNoCase",iter,res,ref);
+      //--- Find and FindNoCase from start position
+      CMTStr1024     cstr(str);
+      const uint32_t start=len ? rng()%len : 0;
+      res=cstr.Find(sub,start);
+      ref=(start<len) ? CrtFind(str+start,sub) : -1;
+      if(ref>=0)
+         ref+=int32_t(start);
+      if(res!=ref)
+         Error(errors,L"Find from position",iter,res,ref);
+      res=cstr.FindNoCase(sub,start);
+      ref=(start<len) ? CrtFindNoCase(str+start,len-start,sub,sublen) : -1;
+      if(ref>=0)
+         ref+=int32_t(start);
+      if(res!=ref)
+         Error(errors,L"FindNoCase from position",iter,res,ref);
+      //--- second string is a mutated copy: changed char, cut or changed case
+      uint32_t cmp_len=len;
+      memcpy(cmp_buf,str_buf,(len+1)*sizeof(wchar_t));
+      switch(rng()%4)
+        {
+         case 1:
+            if(len)
+               cmp_buf[rng()%len]=ExtAlphabet[rng()%_countof(ExtAlphabet)];
+            break;
+         case 2:
+            cmp_len=rng()%(len+1);
+            cmp_buf[cmp_len]=0;
+            break;
+         case 3:
+            for(uint32_t i=0; i<len; i++)
+               if(rng()%2)
+                  cmp_buf[i]=RefFold(cmp_buf[i]);
+            break;
+        }
+      //--- compared string ends before the other guard page with a random misalignment
+      wchar_t *cmp=cmp_end-(cmp_len+1)-(rng()%8);
+      memcpy(cmp,cmp_buf,(cmp_len+1)*sizeof(wchar_t));
+      //--- CompareNoCase
+      res=CMTStr::CompareNoCase(str,cmp);
+      ref=_wcsicmp(str,cmp);
+      if(Sign(res)!=Sign(ref))
+         Error(errors,L"CompareNoCase",iter,res,ref);
+      const uint32_t count=rng()%(len+3);
+      res=CMTStr::CompareNoCase(str,cmp,count);
+      ref=_wcsnicmp(str,cmp,count);
+      if(Sign(res)!=Sign(ref))
+         Error(errors,L"CompareNoCase with count",iter,res,ref);
+     }
+//--- free
+   VirtualFree(mem,0,MEM_RELEASE);
+//--- result
+   wprintf_s(L"%u iterations, %u errors\n",(uint32_t)FUZZ_ITERATIONS,errors);
+   return(errors ? 1 : 0);
+  }
+//+------------------------------------------------------------------+
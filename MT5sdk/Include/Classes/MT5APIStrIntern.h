@@ -0,0 +1,299 @@
+//+------------------------------------------------------------------+
+//|                                                 MetaTrader 5 API |
+//|                             Copyright 2000-2025, MetaQuotes Ltd. |
+//|                                               www.metaquotes.net |
+//+------------------------------------------------------------------+
+#pragma once
+#include <new.h>
+#include <string.h>
+#include <wchar.h>
+#include "MT5APIHashTable.h"
+//+------------------------------------------------------------------+
+//| Strings intern table                                             |
+//| maps names (symbols, groups) to dense IDs starting from 0,       |
+//| IDs are never reused and names are never moved until Shutdown   |
+//| Intern and Find are thread safe, Name and Length are lock free   |
+//| Global() is the table of the module                              |
+//+------------------------------------------------------------------+
+class CMTStrIntern
+  {
+public:
+   //--- constants
+   enum constants
+     {
+      INVALID_ID=0xFFFFFFFF,              // name is not found
+     };
+
+private:
+   enum
+     {
+      PAGE_BITS =12,                      // names per page as power of 2
+      PAGE_SIZE =1<<PAGE_BITS,            // names per page
+      PAGES_MAX =4096,                    // 16M names maximum
+      CHUNK_SIZE=64*1024,                 // names storage chunk size
+     };
+   //--- hash table slot
+   struct Slot
+     {
+      uint32_t          hash;               // low bits of name hash
+      uint32_t          id;                 // name ID, INVALID_ID - empty slot
+     };
+   //--- names storage chunk header
+   struct Chunk
+     {
+      Chunk            *prev;               // previous chunk
+      size_t            size;               // chunk size
+      size_t            used;               // used bytes
+     };
+
+private:
+   LPCWSTR          *m_pages[PAGES_MAX];  // names by ID
+   Slot             *m_slots;             // open addressing hash table
+   uint32_t          m_slots_mask;        // slots count - 1
+   uint32_t          m_total;             // names total
+   Chunk            *m_chunk;             // current names chunk
+   mutable SRWLOCK   m_lock;              // lock
+
+public:
+   //+------------------------------------------------------------------+
+   //| Constructor                                                      |
+   //+------------------------------------------------------------------+
+                     CMTStrIntern(void) : m_slots(NULL),m_slots_mask(0),m_total(0),m_chunk(NULL)
+     {
+      ZeroMemory(m_pages,sizeof(m_pages));
+      InitializeSRWLock(&m_lock);
+     }
+   //+------------------------------------------------------------------+
+   //| Destructor                                                       |
+   //+------------------------------------------------------------------+
+                    ~CMTStrIntern(void)
+     {
+      Shutdown();
+     }
+   //+------------------------------------------------------------------+
+   //| Module wide table                                                |
+   //+------------------------------------------------------------------+
+   static CMTStrIntern& Global(void)
+     {
+      static CMTStrIntern s_intern;
+      return(s_intern);
+     }
+   //+------------------------------------------------------------------+
+   //| Free all memory, IDs and names become invalid                    |
+   //+------------------------------------------------------------------+
+   void Shutdown(void)
+     {
+      AcquireSRWLockExclusive(&m_lock);
+      //--- pages
+      for(uint32_t i=0; i<PAGES_MAX && m_pages[i]; i++)
+        {
+         delete[] m_pages[i];
+         m_pages[i]=NULL;
+        }
+      //--- hash table
+      if(m_slots)
+        {
+         delete[] m_slots;
+         m_slots=NULL;
+        }
+      m_slots_mask=0;
+      m_total     =0;
+      //--- names storage
+      while(m_chunk)
+        {
+         Chunk *prev=m_chunk->prev;
+         delete[] (char*)m_chunk;
+         m_chunk=prev;
+        }
+      ReleaseSRWLockExclusive(&m_lock);
+     }
+   //+------------------------------------------------------------------+
+   //| Names total                                                      |
+   //+------------------------------------------------------------------+
+   uint32_t Total(void) const
+     {
+      AcquireSRWLockShared(&m_lock);
+      uint32_t total=m_total;
+      ReleaseSRWLockShared(&m_lock);
+      return(total);
+     }
+   //+------------------------------------------------------------------+
+   //| Find name ID, INVALID_ID if name is not interned                 |
+   //+------------------------------------------------------------------+
+   uint32_t Find(LPCWSTR name) const
+     {
+      //--- check
+      if(!name)
+         return(INVALID_ID);
+      //--- search under shared lock
+      size_t   len =wcslen(name);
+      uint64_t hash=Hash(name,len);
+      AcquireSRWLockShared(&m_lock);
+      uint32_t id=SlotFind(name,len,hash)->id;
+      ReleaseSRWLockShared(&m_lock);
+      //---
+      return(id);
+     }
+   //+------------------------------------------------------------------+
+   //| Get name ID, the name is added if it is absent                   |
+   //| INVALID_ID on memory error                                       |
+   //+------------------------------------------------------------------+
+   uint32_t Intern(LPCWSTR name)
+     {
+      //--- check
+      if(!name)
+         return(INVALID_ID);
+      //--- most names are already interned
+      size_t   len =wcslen(name);
+      uint64_t hash=Hash(name,len);
+      AcquireSRWLockShared(&m_lock);
+      uint32_t id=SlotFind(name,len,hash)->id;
+      ReleaseSRWLockShared(&m_lock);
+      if(id!=INVALID_ID)
+         return(id);
+      //--- search again and add under exclusive lock
+      AcquireSRWLockExclusive(&m_lock);
+      if((id=SlotFind(name,len,hash)->id)==INVALID_ID)
+         id=NameAdd(name,len,hash);
+      ReleaseSRWLockExclusive(&m_lock);
+      //---
+      return(id);
+     }
+   //+------------------------------------------------------------------+
+   //| Name by ID, NULL for unknown ID                                  |
+   //+------------------------------------------------------------------+
+   LPCWSTR Name(const uint32_t id) const
+     {
+      if(id>=uint32_t(PAGES_MAX*PAGE_SIZE))
+         return(NULL);
+      LPCWSTR *page=m_pages[id >> PAGE_BITS];
+      return(page ? page[id & (PAGE_SIZE-1)] : NULL);
+     }
+   //+------------------------------------------------------------------+
+   //| Name length by ID, 0 for unknown ID                              |
+   //+------------------------------------------------------------------+
+   uint32_t Length(const uint32_t id) const
+     {
+      LPCWSTR name=Name(id);
+      return(name ? ((const uint32_t*)name)[-1] : 0);
+     }
+
+private:
+   //--- prohibit copy constructor and assignment
+                     CMTStrIntern(const CMTStrIntern&)=delete;
+   CMTStrIntern&     operator=(const CMTStrIntern&)=delete;
+   //+------------------------------------------------------------------+
+   //| Name hash                                                        |
+   //+------------------------------------------------------------------+
+   static uint64_t Hash(LPCWSTR name,const size_t len)
+     {
+      return(MTWyHash::Calculate(name,len*sizeof(wchar_t),MTWyHash::SEED));
+     }
+   //+------------------------------------------------------------------+
+   //| Slot with the name or empty slot for it                          |
+   //+------------------------------------------------------------------+
+   const Slot* SlotFind(LPCWSTR name,const size_t len,const uint64_t hash) const
+     {
+      static const Slot empty={0,INVALID_ID};
+      //--- empty table
+      if(!m_slots)
+         return(&empty);
+      //--- linear probing
+      for(uint32_t pos=uint32_t(hash) & m_slots_mask;; pos=(pos+1) & m_slots_mask)
+        {
+         const Slot &slot=m_slots[pos];
+         if(slot.id==INVALID_ID)
+            return(&slot);
+         if(slot.hash==uint32_t(hash) && Length(slot.id)==len && wmemcmp(Name(slot.id),name,len)==0)
+            return(&slot);
+        }
+     }
+   //+------------------------------------------------------------------+
+   //| Add name, called under exclusive lock                            |
+   //+------------------------------------------------------------------+
+   uint32_t NameAdd(LPCWSTR name,const size_t len,const uint64_t hash)
+     {
+      uint32_t id=m_total;
+      //--- check limits
+      if(id>=uint32_t(PAGES_MAX*PAGE_SIZE) || len>=0x7FFFFFFF)
+         return(INVALID_ID);
+      //--- keep load factor under 1/2
+      if((id+1)*2>m_slots_mask && !SlotsResize(m_slots ? (m_slots_mask+1)*2 : 1024))
+         return(INVALID_ID);
+      //--- names page
+      LPCWSTR *&page=m_pages[id >> PAGE_BITS];
+      if(!page)
+        {
+         if((page=new(std::nothrow) LPCWSTR[PAGE_SIZE])==NULL)
+            return(INVALID_ID);
+         ZeroMemory(page,sizeof(LPCWSTR)*PAGE_SIZE);
+        }
+      //--- copy name with length before it
+      wchar_t *str=NameAllocate(len);
+      if(!str)
+         return(INVALID_ID);
+      wmemcpy(str,name,len);
+      str[len]=L'\0';
+      ((uint32_t*)str)[-1]=uint32_t(len);
+      //--- publish
+      page[id & (PAGE_SIZE-1)]=str;
+      Slot *slot=const_cast<Slot*>(SlotFind(name,len,hash));
+      slot->hash=uint32_t(hash);
+      slot->id  =id;
+      m_total++;
+      //---
+      return(id);
+     }
+   //+------------------------------------------------------------------+
+   //| Allocate name storage with length prefix                         |
+   //+------------------------------------------------------------------+
+   wchar_t* NameAllocate(const size_t len)
+     {
+      size_t size=(sizeof(uint32_t)+(len+1)*sizeof(wchar_t)+sizeof(uint32_t)-1) & ~(sizeof(uint32_t)-1);
+      //--- new chunk
+      if(!m_chunk || m_chunk->used+size>m_chunk->size)
+        {
+         size_t chunk_size=sizeof(Chunk)+(size>CHUNK_SIZE ? size : size_t(CHUNK_SIZE));
+         Chunk *chunk=(Chunk*)new(std::nothrow) char[chunk_size];
+         if(!chunk)
+            return(NULL);
+         chunk->prev=m_chunk;
+         chunk->size=chunk_size;
+         chunk->used=sizeof(Chunk);
+         m_chunk    =chunk;
+        }
+      //--- allocate
+      char *ptr=(char*)m_chunk+m_chunk->used;
+      m_chunk->used+=size;
+      //---
+      return((wchar_t*)(ptr+sizeof(uint32_t)));
+     }
+   //+------------------------------------------------------------------+
+   //| Rebuild hash table                                               |
+   //+------------------------------------------------------------------+
+   bool SlotsResize(const uint32_t count)
+     {
+      Slot *slots=new(std::nothrow) Slot[count];
+      if(!slots)
+         return(false);
+      for(uint32_t i=0; i<count; i++)
+         slots[i].id=INVALID_ID;
+      //--- move slots
+      for(uint32_t i=0; m_slots && i<=m_slots_mask; i++)
+         if(m_slots[i].id!=INVALID_ID)
+           {
+            uint32_t pos=m_slots[i].hash & (count-1);
+            while(slots[pos].id!=INVALID_ID)
+               pos=(pos+1) & (count-1);
+            slots[pos]=m_slots[i];
+           }
+      //--- swap
+      if(m_slots)
+         delete[] m_slots;
+      m_slots     =slots;
+      m_slots_mask=count-1;
+      //---
+      return(true);
+     }
+  };
+//+------------------------------------------------------------------+
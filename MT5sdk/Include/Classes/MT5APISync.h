@@ -4,6 +4,122 @@
 //|                                               www.metaquotes.net |
 //+------------------------------------------------------------------+
 #pragma once
+#include <wchar.h>
+//+------------------------------------------------------------------+
+//| Locks statistics, enabled by MTAPI_SYNC_STATS define             |
+//| counts acquisitions, contended acquisitions and wait time,       |
+//| named locks are listed by CMTSyncStat::Dump                      |
+//+------------------------------------------------------------------+
+#ifdef MTAPI_SYNC_STATS
+class CMTSyncStat
+  {
+private:
+   LPCWSTR           m_name;                 // lock name, NULL - not listed
+   volatile LONG64   m_acquired;             // acquisitions total
+   volatile LONG64   m_contended;            // contended acquisitions
+   volatile LONG64   m_wait;                 // wait time in performance counter ticks
+   CMTSyncStat      *m_prev;                 // list of named locks
+   CMTSyncStat      *m_next;
+
+public:
+   //+------------------------------------------------------------------+
+   //| Constructor, named locks are registered in the list              |
+   //+------------------------------------------------------------------+
+   explicit CMTSyncStat(LPCWSTR name) : m_name(name),m_acquired(0),m_contended(0),m_wait(0),m_prev(NULL),m_next(NULL)
+     {
+      if(!m_name)
+         return;
+      AcquireSRWLockExclusive(&ListLock());
+      if((m_next=ListHead())!=NULL)
+         m_next->m_prev=this;
+      ListHead()=this;
+      ReleaseSRWLockExclusive(&ListLock());
+     }
+   //+------------------------------------------------------------------+
+   //| Destructor                                                       |
+   //+------------------------------------------------------------------+
+   ~CMTSyncStat(void)
+     {
+      if(!m_name)
+         return;
+      AcquireSRWLockExclusive(&ListLock());
+      if(m_prev) m_prev->m_next=m_next;
+      else       ListHead()=m_next;
+      if(m_next) m_next->m_prev=m_prev;
+      ReleaseSRWLockExclusive(&ListLock());
+     }
+   //+------------------------------------------------------------------+
+   //| Uncontended acquisition                                          |
+   //+------------------------------------------------------------------+
+   void Acquired(void)
+     {
+      InterlockedIncrement64(&m_acquired);
+     }
+   //+------------------------------------------------------------------+
+   //| Contended acquisition begin, returns start time                  |
+   //+------------------------------------------------------------------+
+   INT64 WaitBegin(void)
+     {
+      LARGE_INTEGER now;
+      InterlockedIncrement64(&m_acquired);
+      InterlockedIncrement64(&m_contended);
+      QueryPerformanceCounter(&now);
+      return(now.QuadPart);
+     }
+   //+------------------------------------------------------------------+
+   //| Contended acquisition end                                        |
+   //+------------------------------------------------------------------+
+   void WaitEnd(const INT64 begin)
+     {
+      LARGE_INTEGER now;
+      QueryPerformanceCounter(&now);
+      InterlockedExchangeAdd64(&m_wait,now.QuadPart-begin);
+     }
+   //+------------------------------------------------------------------+
+   //| Append statistics of named locks to string, one lock per line    |
+   //+------------------------------------------------------------------+
+   template<typename TStr>
+   static void Dump(TStr &str)
+     {
+      LARGE_INTEGER freq;
+      wchar_t       line[256];
+      //--- ticks to nanoseconds
+      QueryPerformanceFrequency(&freq);
+      const double ns=freq.QuadPart ? 1000000000.0/double(freq.QuadPart) : 0.0;
+      //--- print list
+      AcquireSRWLockShared(&ListLock());
+      for(const CMTSyncStat *stat=ListHead(); stat; stat=stat->m_next)
+        {
+         _snwprintf_s(line,_countof(line),_TRUNCATE,L"%s: acquired %I64d, contended %I64d, wait %.0f ns\n",
+                      stat->m_name,stat->m_acquired,stat->m_contended,double(stat->m_wait)*ns);
+         str.Append(line);
+        }
+      ReleaseSRWLockShared(&ListLock());
+     }
+   //+------------------------------------------------------------------+
+   //| Reset statistics of named locks                                  |
+   //+------------------------------------------------------------------+
+   static void Reset(void)
+     {
+      AcquireSRWLockShared(&ListLock());
+      for(CMTSyncStat *stat=ListHead(); stat; stat=stat->m_next)
+        {
+         InterlockedExchange64(&stat->m_acquired ,0);
+         InterlockedExchange64(&stat->m_contended,0);
+         InterlockedExchange64(&stat->m_wait     ,0);
+        }
+      ReleaseSRWLockShared(&ListLock());
+     }
+
+private:
+   //--- prohibit copy constructor and assignment
+                     CMTSyncStat(const CMTSyncStat&);
+   CMTSyncStat&      operator=(const CMTSyncStat&);
+   //--- list of named locks
+   static SRWLOCK&      ListLock(void) { static SRWLOCK s_lock=SRWLOCK_INIT; return(s_lock); }
+   static CMTSyncStat*& ListHead(void) { static CMTSyncStat *s_head=NULL;    return(s_head); }
+  };
+#endif
 //+------------------------------------------------------------------+
 //| Thread synchronization class                                     |
 //+------------------------------------------------------------------+
@@ -11,13 +127,166 @@ class CMTSync
   {
 private:
    CRITICAL_SECTION  m_cs;
+#ifdef MTAPI_SYNC_STATS
+   CMTSyncStat       m_stat;
+#endif
 
 public:
-                     CMTSync(void)      { ZeroMemory(&m_cs,sizeof(m_cs)); InitializeCriticalSection(&m_cs); }
+#ifdef MTAPI_SYNC_STATS
+   explicit          CMTSync(LPCWSTR name=NULL) : m_stat(name) { ZeroMemory(&m_cs,sizeof(m_cs)); InitializeCriticalSection(&m_cs); }
+#else
+   explicit          CMTSync(LPCWSTR /*name*/=NULL)            { ZeroMemory(&m_cs,sizeof(m_cs)); InitializeCriticalSection(&m_cs); }
+#endif
                     ~CMTSync(void)      { DeleteCriticalSection(&m_cs);                  }
 
-   inline void       Lock(void)         { EnterCriticalSection(&m_cs);                   }
+   inline void       Lock(void)
+     {
+#ifdef MTAPI_SYNC_STATS
+      if(TryEnterCriticalSection(&m_cs))
+        {
+         m_stat.Acquired();
+         return;
+        }
+      const INT64 begin=m_stat.WaitBegin();
+      EnterCriticalSection(&m_cs);
+      m_stat.WaitEnd(begin);
+#else
+      EnterCriticalSection(&m_cs);
+#endif
+     }
    inline void       Unlock(void)       { LeaveCriticalSection(&m_cs);                   }
    inline bool       TryLock(void)      { return(TryEnterCriticalSection(&m_cs)!=FALSE); }
   };
 //+------------------------------------------------------------------+
+//| Reader/writer synchronization class                              |
+//| shared locks for readers, exclusive lock for writer,             |
+//| not recursive                                                    |
+//+------------------------------------------------------------------+
+class CMTSyncRW
+  {
+private:
+   SRWLOCK           m_lock;
+#ifdef MTAPI_SYNC_STATS
+   CMTSyncStat       m_stat;
+#endif
+
+public:
+#ifdef MTAPI_SYNC_STATS
+   explicit          CMTSyncRW(LPCWSTR name=NULL) : m_stat(name) { InitializeSRWLock(&m_lock); }
+#else
+   explicit          CMTSyncRW(LPCWSTR /*name*/=NULL)            { InitializeSRWLock(&m_lock); }
+#endif
+                    ~CMTSyncRW(void)    {                                                       }
+
+   inline void       LockRead(void)
+     {
+#ifdef MTAPI_SYNC_STATS
+      if(TryAcquireSRWLockShared(&m_lock))
+        {
+         m_stat.Acquired();
+         return;
+        }
+      const INT64 begin=m_stat.WaitBegin();
+      AcquireSRWLockShared(&m_lock);
+      m_stat.WaitEnd(begin);
+#else
+      AcquireSRWLockShared(&m_lock);
+#endif
+     }
+   inline void       LockWrite(void)
+     {
+#ifdef MTAPI_SYNC_STATS
+      if(TryAcquireSRWLockExclusive(&m_lock))
+        {
+         m_stat.Acquired();
+         return;
+        }
+      const INT64 begin=m_stat.WaitBegin();
+      AcquireSRWLockExclusive(&m_lock);
+      m_stat.WaitEnd(begin);
+#else
+      AcquireSRWLockExclusive(&m_lock);
+#endif
+     }
+   inline void       UnlockRead(void)   { ReleaseSRWLockShared(&m_lock);                        }
+   inline void       UnlockWrite(void)  { ReleaseSRWLockExclusive(&m_lock);                     }
+   inline bool       TryLockRead(void)  { return(TryAcquireSRWLockShared(&m_lock)!=FALSE);      }
+   inline bool       TryLockWrite(void) { return(TryAcquireSRWLockExclusive(&m_lock)!=FALSE);   }
+
+private:
+   //--- prohibit copy constructor and assignment
+                     CMTSyncRW(const CMTSyncRW&);
+   CMTSyncRW&        operator=(const CMTSyncRW&);
+  };
+//+------------------------------------------------------------------+
+//| Spin lock with exponential backoff                               |
+//| for very short critical sections only, not recursive             |
+//+------------------------------------------------------------------+
+class CMTSpin
+  {
+private:
+   enum
+     {
+      SPIN_PAUSES_MAX=1024,                  // pauses limit before yielding the thread
+     };
+   volatile LONG     m_lock;
+#ifdef MTAPI_SYNC_STATS
+   CMTSyncStat       m_stat;
+#endif
+
+public:
+#ifdef MTAPI_SYNC_STATS
+   explicit          CMTSpin(LPCWSTR name=NULL) : m_lock(0),m_stat(name) {}
+#else
+   explicit          CMTSpin(LPCWSTR /*name*/=NULL) : m_lock(0)          {}
+#endif
+
+   inline void       Lock(void)
+     {
+      if(InterlockedCompareExchange(&m_lock,1,0)==0)
+        {
+#ifdef MTAPI_SYNC_STATS
+         m_stat.Acquired();
+#endif
+         return;
+        }
+#ifdef MTAPI_SYNC_STATS
+      const INT64 begin=m_stat.WaitBegin();
+      LockWait();
+      m_stat.WaitEnd(begin);
+#else
+      LockWait();
+#endif
+     }
+   inline void       Unlock(void)       { InterlockedExchange(&m_lock,0);                                  }
+   inline bool       TryLock(void)      { return(m_lock==0 && InterlockedCompareExchange(&m_lock,1,0)==0); }
+
+private:
+   //--- prohibit copy constructor and assignment
+                     CMTSpin(const CMTSpin&);
+   CMTSpin&          operator=(const CMTSpin&);
+   //+------------------------------------------------------------------+
+   //| Wait for the lock, spin on reading with doubling pauses,         |
+   //| yield the thread when pauses reach the limit                     |
+   //+------------------------------------------------------------------+
+   void LockWait(void)
+     {
+      for(uint32_t pauses=1;;)
+        {
+         while(m_lock)
+           {
+            if(pauses<SPIN_PAUSES_MAX)
+              {
+               for(uint32_t i=0; i<pauses; i++)
+                  YieldProcessor();
+               pauses*=2;
+              }
+            else
+               SwitchToThread();
+           }
+         if(InterlockedCompareExchange(&m_lock,1,0)==0)
+            return;
+        }
+     }
+  };
+//+------------------------------------------------------------------+
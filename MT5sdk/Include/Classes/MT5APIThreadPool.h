@@ -0,0 +1,525 @@
+//+------------------------------------------------------------------+
+//|                                                 MetaTrader 5 API |
+//|                             Copyright 2000-2025, MetaQuotes Ltd. |
+//|                                               www.metaquotes.net |
+//+------------------------------------------------------------------+
+#pragma once
+#include <new.h>
+#include <wchar.h>
+#include <utility>
+#include "MT5APISync.h"
+#include "MT5APIThread.h"
+//+------------------------------------------------------------------+
+//| Wait group, counts unfinished tasks                              |
+//+------------------------------------------------------------------+
+class CMTWaitGroup
+  {
+private:
+   volatile LONG     m_count;                // unfinished tasks
+   SRWLOCK           m_lock;                 // lock of condition
+   CONDITION_VARIABLE m_cond;                // condition of zero count
+
+public:
+                     CMTWaitGroup(void) : m_count(0) { InitializeSRWLock(&m_lock); InitializeConditionVariable(&m_cond); }
+                    ~CMTWaitGroup(void)              {                                                                  }
+   //--- tasks counter
+   void              Add(const LONG count)           { InterlockedExchangeAdd(&m_count,count); }
+   bool              IsDone(void) const              { return(m_count==0);                      }
+   //+------------------------------------------------------------------+
+   //| Task finished                                                    |
+   //+------------------------------------------------------------------+
+   void Done(void)
+     {
+      if(InterlockedDecrement(&m_count)==0)
+        {
+         AcquireSRWLockExclusive(&m_lock);
+         WakeAllConditionVariable(&m_cond);
+         ReleaseSRWLockExclusive(&m_lock);
+        }
+     }
+   //+------------------------------------------------------------------+
+   //| Wait for all tasks, false on timeout                             |
+   //+------------------------------------------------------------------+
+   bool Wait(const DWORD timeout=INFINITE)
+     {
+      AcquireSRWLockExclusive(&m_lock);
+      while(m_count)
+         if(!SleepConditionVariableSRW(&m_cond,&m_lock,timeout,0))
+            break;
+      const bool res=(m_count==0);
+      ReleaseSRWLockExclusive(&m_lock);
+      return(res);
+     }
+
+private:
+   //--- prohibit copy constructor and assignment
+                     CMTWaitGroup(const CMTWaitGroup&)=delete;
+   CMTWaitGroup&     operator=(const CMTWaitGroup&)=delete;
+  };
+//+------------------------------------------------------------------+
+//| Thread pool with work stealing                                   |
+//| each worker has own deque of tasks: the owner takes the newest   |
+//| task, idle workers steal the oldest tasks of others,             |
+//| tasks submitted from outside are spread over workers in turn     |
+//+------------------------------------------------------------------+
+class CMTThreadPool
+  {
+public:
+   //--- task function
+   typedef void      (*TaskFunc)(void *param);
+   //--- affinity modes
+   enum EnAffinity
+     {
+      AFFINITY_NONE  =0,                     // threads are not bound
+      AFFINITY_SPREAD=1,                     // worker i is bound to i-th processor of the mask
+     };
+
+private:
+   enum
+     {
+      DEQUE_INITIAL=256,                     // initial deque size
+      WAIT_HELP_MS =1,                       // wait timeout between help attempts
+     };
+   //--- task
+   struct Task
+     {
+      TaskFunc          func;                // function
+      void             *param;               // function parameter
+      CMTWaitGroup     *group;               // wait group of task
+     };
+   //--- worker with own deque, aligned to avoid false sharing
+   struct alignas(64) Worker
+     {
+      CMTThread         thread;              // thread
+      CMTSpin           lock;                // deque lock
+      Task             *tasks;               // deque ring buffer
+      uint64_t          mask;                // deque size - 1
+      volatile uint64_t head;                // oldest task
+      volatile uint64_t tail;                // next after newest task
+      CMTThreadPool    *pool;                // owner pool
+      uint32_t          index;               // worker index
+      uint32_t          seed;                // random victim selection
+     };
+   //--- context of ParallelFor
+   template<typename TFunc>
+   struct ForContext
+     {
+      TFunc            *func;                // range functor
+      uint64_t          begin;               // range begin
+      uint64_t          end;                 // range end
+      uint64_t          grain;               // chunk size
+      volatile LONG64   next;                // next chunk
+     };
+
+private:
+   Worker           *m_workers;              // workers
+   uint32_t          m_workers_total;        // workers count
+   volatile LONG     m_submit_next;          // next worker for outside tasks
+   volatile LONG     m_pending;              // queued tasks
+   volatile LONG     m_sleeping;             // sleeping workers
+   volatile LONG     m_stop;                 // stop flag
+   SRWLOCK           m_idle_lock;            // idle lock
+   CONDITION_VARIABLE m_idle_cond;           // idle condition
+   wchar_t           m_name[64];             // threads name
+
+public:
+   //+------------------------------------------------------------------+
+   //| Constructor                                                      |
+   //+------------------------------------------------------------------+
+                     CMTThreadPool(void) : m_workers(NULL),m_workers_total(0),m_submit_next(0),m_pending(0),m_sleeping(0),m_stop(0)
+     {
+      m_name[0]=L'\0';
+      InitializeSRWLock(&m_idle_lock);
+      InitializeConditionVariable(&m_idle_cond);
+     }
+   //+------------------------------------------------------------------+
+   //| Destructor                                                       |
+   //+------------------------------------------------------------------+
+                    ~CMTThreadPool(void)
+     {
+      Shutdown();
+     }
+   //+------------------------------------------------------------------+
+   //| Start workers                                                    |
+   //| threads       - workers count, 0 - by processors count           |
+   //| name          - threads name for debuggers and profilers         |
+   //| affinity      - EnAffinity mode                                  |
+   //| affinity_mask - processors for AFFINITY_SPREAD, 0 - process mask |
+   //+------------------------------------------------------------------+
+   bool Initialize(uint32_t threads=0,LPCWSTR name=NULL,const uint32_t affinity=AFFINITY_NONE,uint64_t affinity_mask=0,const uint32_t stack_size=0)
+     {
+      //--- check
+      if(m_workers)
+         return(false);
+      //--- workers count
+      if(!threads)
+        {
+         SYSTEM_INFO info={};
+         GetSystemInfo(&info);
+         threads=info.dwNumberOfProcessors ? info.dwNumberOfProcessors : 1;
+        }
+      //--- processors for affinity
+      if(affinity==AFFINITY_SPREAD && !affinity_mask)
+        {
+         DWORD_PTR process_mask=0,system_mask=0;
+         if(GetProcessAffinityMask(GetCurrentProcess(),&process_mask,&system_mask))
+            affinity_mask=process_mask;
+        }
+      //--- threads name
+      if(name)
+         wcsncpy_s(m_name,_countof(m_name),name,_TRUNCATE);
+      else
+         m_name[0]=L'\0';
+      //--- workers
+      if((m_workers=new(std::nothrow) Worker[threads]())==NULL)
+         return(false);
+      m_workers_total=threads;
+      m_submit_next  =0;
+      m_pending      =0;
+      m_stop         =0;
+      for(uint32_t i=0; i<threads; i++)
+        {
+         Worker &worker=m_workers[i];
+         worker.mask =DEQUE_INITIAL-1;
+         worker.head =worker.tail=0;
+         worker.pool =this;
+         worker.index=i;
+         worker.seed =i*0x9E3779B9u+1;
+         if((worker.tasks=new(std::nothrow) Task[DEQUE_INITIAL])==NULL)
+           {
+            Shutdown();
+            return(false);
+           }
+        }
+      //--- start threads
+      for(uint32_t i=0; i<threads; i++)
+        {
+         Worker &worker=m_workers[i];
+         if(!worker.thread.Start(WorkerThread,&worker,stack_size))
+           {
+            Shutdown();
+            return(false);
+           }
+         ThreadSetup(worker,affinity,affinity_mask);
+        }
+      //--- ok
+      return(true);
+     }
+   //+------------------------------------------------------------------+
+   //| Stop workers, queued tasks are completed before                  |
+   //+------------------------------------------------------------------+
+   void Shutdown(void)
+     {
+      if(!m_workers)
+         return;
+      //--- stop and wake all
+      InterlockedExchange(&m_stop,1);
+      AcquireSRWLockExclusive(&m_idle_lock);
+      WakeAllConditionVariable(&m_idle_cond);
+      ReleaseSRWLockExclusive(&m_idle_lock);
+      //--- wait threads
+      for(uint32_t i=0; i<m_workers_total; i++)
+         m_workers[i].thread.Shutdown();
+      //--- free
+      for(uint32_t i=0; i<m_workers_total; i++)
+         if(m_workers[i].tasks)
+            delete[] m_workers[i].tasks;
+      delete[] m_workers;
+      m_workers      =NULL;
+      m_workers_total=0;
+     }
+   //+------------------------------------------------------------------+
+   //| Workers count                                                    |
+   //+------------------------------------------------------------------+
+   uint32_t Threads(void) const
+     {
+      return(m_workers_total);
+     }
+   //+------------------------------------------------------------------+
+   //| Submit task, the group is signaled on completion                 |
+   //+------------------------------------------------------------------+
+   bool Submit(TaskFunc func,void *param,CMTWaitGroup *group=NULL)
+     {
+      //--- check
+      if(!func || !m_workers || m_stop)
+         return(false);
+      //--- push task
+      const Task task={func,param,group};
+      if(group)
+         group->Add(1);
+      if(!Push(task))
+        {
+         if(group)
+            group->Done();
+         return(false);
+        }
+      //--- wake sleeping worker
+      if(m_sleeping)
+        {
+         AcquireSRWLockExclusive(&m_idle_lock);
+         WakeConditionVariable(&m_idle_cond);
+         ReleaseSRWLockExclusive(&m_idle_lock);
+        }
+      return(true);
+     }
+   //+------------------------------------------------------------------+
+   //| Submit functor, it is copied to heap till completion             |
+   //+------------------------------------------------------------------+
+   template<typename TFunc>
+   bool Submit(TFunc &&func,CMTWaitGroup *group=NULL)
+     {
+      typedef typename std::decay<TFunc>::type TFunctor;
+      //--- copy functor
+      TFunctor *functor=new(std::nothrow) TFunctor(std::forward<TFunc>(func));
+      if(!functor)
+         return(false);
+      //--- submit
+      if(Submit(&FunctorRun<TFunctor>,functor,group))
+         return(true);
+      delete functor;
+      return(false);
+     }
+   //+------------------------------------------------------------------+
+   //| Call func(from,to) over [begin,end) by chunks of grain size,     |
+   //| grain 0 - automatic, the calling thread takes part in work,      |
+   //| returns when the whole range is processed                        |
+   //+------------------------------------------------------------------+
+   template<typename TFunc>
+   void ParallelFor(const uint64_t begin,const uint64_t end,uint64_t grain,TFunc &&func)
+     {
+      //--- check
+      if(begin>=end)
+         return;
+      //--- chunk size
+      const uint64_t count=end-begin;
+      if(!grain)
+        {
+         grain=count/(uint64_t(m_workers_total+1)*4);
+         if(!grain)
+            grain=1;
+        }
+      const uint64_t chunks=(count+grain-1)/grain;
+      //--- context on stack, it lives until the group is done
+      typedef typename std::remove_reference<TFunc>::type TFunctor;
+      ForContext<TFunctor> context={&func,begin,end,grain,0};
+      CMTWaitGroup         group;
+      //--- helpers, the caller is one of the runners
+      const uint64_t helpers=chunks-1<m_workers_total ? chunks-1 : m_workers_total;
+      for(uint64_t i=0; i<helpers; i++)
+         if(!Submit(&ForRun<TFunctor>,&context,&group))
+            break;
+      //--- work and wait
+      ForRun<TFunctor>(&context);
+      Wait(group);
+     }
+   //+------------------------------------------------------------------+
+   //| Wait for the group, the thread runs queued tasks meanwhile       |
+   //+------------------------------------------------------------------+
+   void Wait(CMTWaitGroup &group)
+     {
+      Task task;
+      while(!group.IsDone())
+        {
+         if(TaskGet(CurrentWorker(),task))
+            TaskRun(task);
+         else
+            group.Wait(WAIT_HELP_MS);
+        }
+     }
+
+private:
+   //--- prohibit copy constructor and assignment
+                     CMTThreadPool(const CMTThreadPool&)=delete;
+   CMTThreadPool&    operator=(const CMTThreadPool&)=delete;
+   //+------------------------------------------------------------------+
+   //| Worker of the current thread in this pool, NULL if none          |
+   //+------------------------------------------------------------------+
+   Worker* CurrentWorker(void) const
+     {
+      Worker *worker=CurrentWorkerRef();
+      return(worker && worker->pool==this ? worker : NULL);
+     }
+   static Worker*& CurrentWorkerRef(void)
+     {
+      static thread_local Worker *s_worker=NULL;
+      return(s_worker);
+     }
+   //+------------------------------------------------------------------+
+   //| Push task to own deque or to the next worker deque               |
+   //+------------------------------------------------------------------+
+   bool Push(const Task &task)
+     {
+      Worker *worker=CurrentWorker();
+      if(!worker)
+         worker=&m_workers[uint32_t(InterlockedIncrement(&m_submit_next))%m_workers_total];
+      //--- push back
+      worker->lock.Lock();
+      if(worker->tail-worker->head>worker->mask && !DequeGrow(*worker))
+        {
+         worker->lock.Unlock();
+         return(false);
+        }
+      worker->tasks[worker->tail & worker->mask]=task;
+      worker->tail++;
+      InterlockedIncrement(&m_pending);
+      worker->lock.Unlock();
+      return(true);
+     }
+   //+------------------------------------------------------------------+
+   //| Double deque size, called under deque lock                       |
+   //+------------------------------------------------------------------+
+   static bool DequeGrow(Worker &worker)
+     {
+      const uint64_t size=(worker.mask+1)*2;
+      Task *tasks=new(std::nothrow) Task[size];
+      if(!tasks)
+         return(false);
+      for(uint64_t i=worker.head; i<worker.tail; i++)
+         tasks[i & (size-1)]=worker.tasks[i & worker.mask];
+      delete[] worker.tasks;
+      worker.tasks=tasks;
+      worker.mask =size-1;
+      return(true);
+     }
+   //+------------------------------------------------------------------+
+   //| Get task: the newest of own deque or the oldest of other ones    |
+   //+------------------------------------------------------------------+
+   bool TaskGet(Worker *self,Task &task)
+     {
+      //--- own deque
+      if(self && self->tail!=self->head)
+        {
+         self->lock.Lock();
+         const bool res=(self->tail!=self->head);
+         if(res)
+            task=self->tasks[--self->tail & self->mask];
+         self->lock.Unlock();
+         if(res)
+           {
+            InterlockedDecrement(&m_pending);
+            return(true);
+           }
+        }
+      //--- steal, start from random victim
+      if(!m_pending)
+         return(false);
+      uint32_t start=0;
+      if(self)
+        {
+         self->seed^=self->seed<<13; self->seed^=self->seed>>17; self->seed^=self->seed<<5;
+         start=self->seed;
+        }
+      for(uint32_t i=0; i<m_workers_total; i++)
+        {
+         Worker &victim=m_workers[(start+i)%m_workers_total];
+         if(&victim==self || victim.tail==victim.head)
+            continue;
+         victim.lock.Lock();
+         const bool res=(victim.tail!=victim.head);
+         if(res)
+            task=victim.tasks[victim.head++ & victim.mask];
+         victim.lock.Unlock();
+         if(res)
+           {
+            InterlockedDecrement(&m_pending);
+            return(true);
+           }
+        }
+      return(false);
+     }
+   //+------------------------------------------------------------------+
+   //| Run task                                                         |
+   //+------------------------------------------------------------------+
+   static void TaskRun(const Task &task)
+     {
+      task.func(task.param);
+      if(task.group)
+         task.group->Done();
+     }
+   //+------------------------------------------------------------------+
+   //| Worker thread                                                    |
+   //+------------------------------------------------------------------+
+   static unsigned __stdcall WorkerThread(void *param)
+     {
+      Worker        *worker=(Worker*)param;
+      CMTThreadPool *pool  =worker->pool;
+      Task           task;
+      CurrentWorkerRef()=worker;
+      //--- loop till stop and empty queues
+      for(;;)
+        {
+         if(pool->TaskGet(worker,task))
+           {
+            TaskRun(task);
+            continue;
+           }
+         //--- sleep while no tasks, m_sleeping is published before m_pending is checked
+         AcquireSRWLockExclusive(&pool->m_idle_lock);
+         InterlockedIncrement(&pool->m_sleeping);
+         while(!pool->m_pending && !pool->m_stop)
+            SleepConditionVariableSRW(&pool->m_idle_cond,&pool->m_idle_lock,INFINITE,0);
+         InterlockedDecrement(&pool->m_sleeping);
+         const bool stop=pool->m_stop && !pool->m_pending;
+         ReleaseSRWLockExclusive(&pool->m_idle_lock);
+         if(stop)
+            break;
+        }
+      CurrentWorkerRef()=NULL;
+      return(0);
+     }
+   //+------------------------------------------------------------------+
+   //| Thread name and affinity                                         |
+   //+------------------------------------------------------------------+
+   void ThreadSetup(Worker &worker,const uint32_t affinity,const uint64_t affinity_mask)
+     {
+      typedef HRESULT (WINAPI *SetThreadDescriptionPtr)(HANDLE,PCWSTR);
+      //--- name, SetThreadDescription is available since Windows 10 1607
+      if(m_name[0])
+         if(HMODULE kernel=GetModuleHandleW(L"kernel32.dll"))
+            if(SetThreadDescriptionPtr set_description=(SetThreadDescriptionPtr)GetProcAddress(kernel,"SetThreadDescription"))
+              {
+               wchar_t name[80];
+               _snwprintf_s(name,_countof(name),_TRUNCATE,L"%s #%u",m_name,worker.index);
+               set_description(worker.thread.Handle(),name);
+              }
+      //--- bind to worker.index-th processor of the mask
+      if(affinity==AFFINITY_SPREAD && affinity_mask)
+        {
+         uint32_t processors=0;
+         for(uint64_t mask=affinity_mask; mask; mask&=mask-1)
+            processors++;
+         uint32_t skip=worker.index%processors;
+         uint64_t mask=affinity_mask;
+         while(skip--)
+            mask&=mask-1;
+         SetThreadAffinityMask(worker.thread.Handle(),DWORD_PTR(mask & (~mask+1)));
+        }
+     }
+   //+------------------------------------------------------------------+
+   //| Heap functor task                                                |
+   //+------------------------------------------------------------------+
+   template<typename TFunctor>
+   static void FunctorRun(void *param)
+     {
+      TFunctor *functor=(TFunctor*)param;
+      (*functor)();
+      delete functor;
+     }
+   //+------------------------------------------------------------------+
+   //| ParallelFor runner, takes chunks until the range ends            |
+   //+------------------------------------------------------------------+
+   template<typename TFunctor>
+   static void ForRun(void *param)
+     {
+      ForContext<TFunctor> *context=(ForContext<TFunctor>*)param;
+      for(;;)
+        {
+         const uint64_t from=context->begin+uint64_t(InterlockedIncrement64(&context->next)-1)*context->grain;
+         if(from>=context->end)
+            break;
+         const uint64_t to=context->end-from>context->grain ? from+context->grain : context->end;
+         (*context->func)(from,to);
+        }
+     }
+  };
+//+------------------------------------------------------------------+
@@ -33,6 +33,7 @@ private:
 public:
    //--- time functions
    static bool       ParseTime(const int64_t ctm,tm *ttm);
+   static bool       ParseTimes(const int64_t *ctm,tm *ttm,const size_t total);
    static int64_t    MakeTime(tm *ttm);
    static LPCWSTR    MonthName(const uint8_t month);
    static LPCWSTR    MonthNameShort(const uint8_t month);
@@ -50,6 +51,11 @@ public:
    static uint32_t   Hour(const int64_t ctm);
    static uint32_t   Min(const int64_t ctm);
    static uint32_t   Sec(const int64_t ctm);
+
+private:
+   //--- calendar date of day since 1970.01.01
+   static void       DayToDate(const int64_t day,tm *ttm);
+   static void       DayTime(const int64_t ctm,const int64_t day,const tm &date,tm *ttm);
   };
 //+------------------------------------------------------------------+
 //|                                                                  |
@@ -76,8 +82,90 @@ inline bool SMTTime::ParseTime(const int64_t ctm,tm *ttm)
       ZeroMemory(ttm,sizeof(*ttm));
       return(false);
      }
+//--- the current day of the thread, consecutive times differ by time only
+   static thread_local int64_t cache_day=-1;
+   static thread_local tm      cache_date={};
+   const int64_t day=ctm/SECONDS_IN_DAY;
+   if(day!=cache_day)
+     {
+      DayToDate(day,&cache_date);
+      cache_day=day;
+     }
+//--- parse
+   DayTime(ctm,day,cache_date,ttm);
+   return(true);
+  }
+//+------------------------------------------------------------------+
+//| Batch time parsing, invalid times are zeroed                     |
+//+------------------------------------------------------------------+
+inline bool SMTTime::ParseTimes(const int64_t *ctm,tm *ttm,const size_t total)
+  {
+   int64_t last_day=-1;
+   tm      date    ={};
+   bool    res     =true;
+//--- check
+   if(!ctm || !ttm)
+      return(false);
 //--- parse
-   return(_gmtime64_s(ttm,&ctm)==0);
+   for(size_t i=0; i<total; i++)
+     {
+      //--- check time
+      if(ctm[i]<0 || ctm[i]>=s_max_time64_t)
+        {
+         ZeroMemory(&ttm[i],sizeof(ttm[i]));
+         res=false;
+         continue;
+        }
+      //--- the date is calculated once per day
+      const int64_t day=ctm[i]/SECONDS_IN_DAY;
+      if(day!=last_day)
+        {
+         DayToDate(day,&date);
+         last_day=day;
+        }
+      DayTime(ctm[i],day,date,&ttm[i]);
+     }
+//---
+   return(res);
+  }
+//+------------------------------------------------------------------+
+//| Calendar date by days since 1970.01.01                           |
+//| civil_from_days algorithm by H.Hinnant, eras of 400 years        |
+//+------------------------------------------------------------------+
+inline void SMTTime::DayToDate(const int64_t day,tm *ttm)
+  {
+//--- shift epoch to 0000.03.01, leap day is the last day of year
+   const int64_t  days=day+719468;
+   const int64_t  era =days/146097;
+   const uint32_t doe =uint32_t(days-era*146097);                    // [0, 146096]
+   const uint32_t yoe =(doe-doe/1460+doe/36524-doe/146096)/365;      // [0, 399]
+   const uint32_t doy =doe-(365*yoe+yoe/4-yoe/100);                  // [0, 365]
+   const uint32_t mp  =(5*doy+2)/153;                                // [0, 11] from March
+   const uint32_t mday=doy-(153*mp+2)/5+1;                           // [1, 31]
+   const uint32_t mon =mp<10 ? mp+2 : mp-10;                         // [0, 11] from January
+   const int64_t  year=int64_t(yoe)+era*400+(mon<2 ? 1 : 0);
+   const uint32_t leap=(year%4==0 && (year%100!=0 || year%400==0)) ? 1 : 0;
+//--- date
+   ZeroMemory(ttm,sizeof(*ttm));
+   ttm->tm_year=int(year-1900);
+   ttm->tm_mon =int(mon);
+   ttm->tm_mday=int(mday);
+   ttm->tm_yday=int(doy>=306 ? doy-306 : doy+59+leap);
+   ttm->tm_wday=int((day+4)%7);                                       // 1970.01.01 is Thursday
+  }
+//+------------------------------------------------------------------+
+//| Date and time of day                                             |
+//+------------------------------------------------------------------+
+inline void SMTTime::DayTime(const int64_t ctm,const int64_t day,const tm &date,tm *ttm)
+  {
+   uint32_t secs=uint32_t(ctm-day*SECONDS_IN_DAY);
+//--- date
+   *ttm=date;
+//--- time
+   ttm->tm_hour=int(secs/3600);
+   secs%=3600;
+   ttm->tm_min =int(secs/60);
+   ttm->tm_sec =int(secs%60);
   }
 //+------------------------------------------------------------------+
 //| Time conversion                                                  |
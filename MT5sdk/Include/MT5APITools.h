@@ -7,17 +7,29 @@
 #include <cstdint>
 #include "Classes\MT5APIStr.h"
 #include "Classes\MT5APIMath.h"
+#include "Classes\MT5APIMoney.h"
 #include "Classes\MT5APIFormat.h"
 #include "Classes\MT5APITime.h"
+#include "Classes\MT5APIArena.h"
 #include "Classes\MT5APIStorage.h"
 #include "Classes\MT5APISync.h"
 #include "Classes\MT5APIThread.h"
 #include "Classes\MT5APIProcess.h"
 #include "Classes\MT5APIFile.h"
+#include "Classes\MT5APIFileMap.h"
+#include "Classes\MT5APIFileWriter.h"
 #include "Classes\MT5APIMemPack.h"
 //--- C++11 and higher
 #if __cplusplus>=201103L || (defined(_MSVC_LANG) && _MSVC_LANG>=201103L)
 #include "Classes\MT5APIHashTable.h"
+#include "Classes\MT5APIFlatHashTable.h"
+#include "Classes\MT5APIConcurrentHashTable.h"
 #include "Classes\MT5APIPtr.h"
+#include "Classes\MT5APIBTree.h"
+#include "Classes\MT5APIGroupMask.h"
+#include "Classes\MT5APIStrIntern.h"
+#include "Classes\MT5APIThreadPool.h"
+#include "Classes\MT5APIQueue.h"
+#include "Classes\MT5APILoginSet.h"
 #endif
 //+------------------------------------------------------------------+